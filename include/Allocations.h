@@ -0,0 +1,40 @@
+#ifndef ALLOCATIONS_H
+#define ALLOCATIONS_H
+#include "Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Heap allocation counts per mesh phase. The phase is the innermost open
+// Trace::Span of the allocating thread. Counting needs the replaced global
+// operator new and delete of AllocationHooks.cpp, which only mesh-generator
+// links (the library leaves its host's allocator alone). Frees are counted
+// in the phase that frees, not the one that allocated.
+class Allocations {
+private:
+  static const unsigned maxPhases = 64;
+  static std::atomic<bool> enabled;
+  static std::atomic<unsigned> numPhases;
+  static const char *names[maxPhases];
+  static std::atomic<unsigned long long> counts[maxPhases];
+  static std::atomic<unsigned long long> bytes[maxPhases];
+  static std::atomic<unsigned long long> frees[maxPhases];
+  static std::mutex lock; // Guards adding a phase
+
+protected:
+  static unsigned phaseIndex(const char *); // Slot of a phase, added if new
+
+public:
+  static void enable();             // Start counting, clears the counts
+  static void disable();            // Stop counting
+  static void allocated(std::size_t); // Called by operator new
+  static void freed();              // Called by operator delete
+  static std::string report();      // Per-phase table, most allocations first
+};
+
+#endif /*__ALLOCATIONS_H__*/
@@ -0,0 +1,61 @@
+#ifndef ASSEMBLY_H
+#define ASSEMBLY_H
+#include "Coloring.h"
+#include "Graph.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Linear (P1) finite element assembly over a flat triangulation into a
+// compressed sparse row matrix. The sparsity pattern comes from the node
+// graph and is built once; each element also stores where its entries land,
+// so assembly is a pure scatter. Elements are swept one Coloring group at a
+// time, which lets threads assemble a color without atomics.
+class Assembly {
+public:
+  enum Problem { POISSON, ELASTICITY };
+
+private:
+  Problem problem;
+  unsigned dofsPerNode; // 1 for Poisson, 2 for plane elasticity
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  std::vector<unsigned> rowStart;   // CSR row offsets
+  std::vector<unsigned> columns;    // CSR column indices, sorted per row
+  std::vector<double> values;       // CSR values
+  std::vector<double> rhs;          // Load vector
+  std::vector<unsigned> slots;      // Value index of each element entry,
+                                    // elements in color order
+  Coloring coloring;                // Conflict-free element groups
+
+protected:
+  void buildPattern(); // Sparsity pattern and element slots
+  void assembleRange(unsigned, unsigned); // Colored elements [begin, end)
+
+public:
+  // Constructors
+  Assembly() : problem(POISSON), dofsPerNode(1){};
+  Assembly(const std::vector<double> &, const std::vector<double> &,
+           const std::vector<unsigned> &, Problem = POISSON);
+  // Public methods
+  void assemble(unsigned = 1);      // Zero and assemble matrix and load
+  double benchmark(unsigned = 1);   // Elements assembled per second
+  unsigned rows() const;            // Number of matrix rows
+  unsigned nonzeros() const;        // Number of stored entries
+  unsigned numColors() const;       // Colors used by the element coloring
+  const std::vector<unsigned> &getRowStart() const; // CSR row offsets
+  const std::vector<unsigned> &getColumns() const;  // CSR columns
+  const std::vector<double> &getValues() const;     // CSR values
+  const std::vector<double> &getRhs() const;        // Load vector
+  void printMatrix(const char *) const;             // CSR to file
+};
+
+#endif /*__ASSEMBLY_H__*/
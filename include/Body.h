@@ -2,6 +2,7 @@
 #define BODY_H
 #include "Element.h"
 #include "Node.h"
+#include "Trace.h"
 #include <cstdlib>
 #include <exception>
 #include <fstream>
@@ -33,6 +34,8 @@ public:
   // Constructors
   Body() : x_size(0), y_size(0), vertices(0){};
   Body(char *);
+  Body(double, double, double, double, double,
+       double); // Sizes, then lower left and upper right corner
   Body(const Body &); // Copy
   // Destructor
   ~Body();
@@ -0,0 +1,59 @@
+#ifndef COLORING_H
+#define COLORING_H
+#include "Trace.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Node-sharing conflict coloring of the elements of a flat triangulation:
+// no two elements of one color share a node, so a loop over one color may
+// scatter to nodes from several threads without races. Elements of each
+// color are stored contiguously, together with a copy of their
+// connectivity in the same order, so a sweep over a color reads memory
+// front to back.
+class Coloring {
+public:
+  enum Method { GREEDY, JONES_PLASSMANN };
+
+private:
+  unsigned numNodes;
+  unsigned numThreads;
+  std::vector<int> colors;           // Color of each element
+  std::vector<unsigned> colorStart;  // Color c is [colorStart[c],
+  std::vector<unsigned> colorElems;  // colorStart[c + 1]) of colorElems
+  std::vector<unsigned> colorConn;   // 3 nodes per entry of colorElems
+  std::vector<unsigned> nodeStart;   // Node to element incidence (CSR)
+  std::vector<unsigned> incident;
+
+protected:
+  void buildIncidence(const std::vector<unsigned> &);
+  void greedy(const std::vector<unsigned> &); // First fit in element order
+  void jonesPlassmann(const std::vector<unsigned> &); // Parallel rounds
+  void selectRange(const std::vector<unsigned> &,
+                   const std::vector<unsigned> &, unsigned, unsigned,
+                   std::vector<char> &) const; // Local maxima of a round
+  void colorRange(const std::vector<unsigned> &,
+                  const std::vector<unsigned> &, const std::vector<char> &,
+                  unsigned, unsigned); // Color the selected elements
+  int firstFreeColor(const std::vector<unsigned> &, unsigned,
+                     std::vector<unsigned> &) const;
+  void layout(const std::vector<unsigned> &); // Per-color contiguous lists
+
+public:
+  // Constructors
+  Coloring() : numNodes(0), numThreads(1){};
+  Coloring(const std::vector<unsigned> &, unsigned, Method = GREEDY,
+           unsigned = 1); // Connectivity, number of nodes, method, threads
+  // Public methods
+  unsigned numColors() const;                   // Colors used
+  const std::vector<int> &getColors() const;    // Color of each element
+  unsigned colorBegin(unsigned) const;          // First entry of a color
+  unsigned colorEnd(unsigned) const;            // One past its last entry
+  const std::vector<unsigned> &getElements() const;     // Grouped by color
+  const std::vector<unsigned> &getConnectivity() const; // Same order
+  bool isValid(const std::vector<unsigned> &) const;    // No conflicts
+};
+
+#endif /*__COLORING_H__*/
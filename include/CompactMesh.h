@@ -0,0 +1,72 @@
+#ifndef COMPACTMESH_H
+#define COMPACTMESH_H
+#include "EdgeTable.h"
+#include "Predicates.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Memory-lean triangulation for very large meshes: single precision
+// coordinates, 32-bit node indices and a packed array of element neighbors,
+// instead of objects linked by 64-bit pointers. It can mesh points itself,
+// so nothing larger ever exists: each node is inserted by a walk over the
+// neighbor array, splits the element holding it and is flipped into place,
+// keeping the mesh Delaunay as it grows. Predicates promote the floats to
+// double, which holds them exactly, so they stay robust on the rounded
+// coordinates. The flip test is Triangulation's, isLocallyDelaunay(), so
+// cocircular ties are broken the same way.
+class CompactMesh {
+private:
+  std::vector<float> x, y;        // Node coordinates
+  std::vector<uint32_t> conn;     // 3 node indices per element
+  std::vector<int32_t> neighbors; // 3 per element, across from vertex k
+  std::vector<uint32_t> pending;  // Elements at the new node, to check
+  unsigned inverted;              // Elements flipped or flattened by floats
+  uint32_t last;                  // Element the next walk starts from
+  unsigned flips;                 // Flips made while inserting
+  unsigned skipped;               // Nodes on a node, or outside the box
+
+protected:
+  double side(uint32_t, int, double, double) const; // orient2d, edge k
+  bool isLegal(uint32_t, uint32_t, uint32_t,
+               uint32_t) const; // Keep shared edge of quad?
+  void setElement(uint32_t, uint32_t, uint32_t, uint32_t, int32_t, int32_t,
+                  int32_t); // Vertices, then neighbors across them
+  uint32_t addElement(uint32_t, uint32_t, uint32_t, int32_t, int32_t,
+                      int32_t); // Same, for a new element
+  void replaceNeighbor(int32_t, int32_t, int32_t); // Old neighbor to new
+  void legalize();                                 // Flip pending elements
+
+public:
+  // Constructors
+  CompactMesh() : inverted(0), last(0), flips(0), skipped(0){};
+  CompactMesh(double, double, double, double,
+              std::size_t = 0); // Box to mesh inside, nodes to reserve
+  CompactMesh(const std::vector<double> &, const std::vector<double> &,
+              const std::vector<unsigned> &); // From flat double arrays
+  // Public methods
+  bool insert(double, double);              // Add node; false if skipped
+  void renumber(const std::vector<uint32_t> &); // New index of each node
+  void trim();                              // Free reserve skipped nodes left
+  unsigned numNodes() const;                // Number of nodes
+  unsigned numElements() const;             // Number of elements
+  unsigned numInverted() const;             // Elements broken by rounding
+  unsigned numFlips() const;                // Flips made by insert()
+  unsigned numSkipped() const;              // Nodes insert() left out
+  double orientation(unsigned) const;       // orient2d of element, in double
+  int neighbor(unsigned, int) const;        // Element across vertex, or -1
+  const std::vector<uint32_t> &getConnectivity() const; // 3 per element
+  void getArrays(std::vector<double> &, std::vector<double> &,
+                 std::vector<unsigned> &) const; // Flat double copy
+  std::size_t bytes() const;                // Memory held by the arrays
+  double bytesPerTriangle() const;          // bytes() over element count
+  void printMesh(const char *) const;       // Text mesh to file
+  void printBinary(const char *) const;     // Float binary mesh to file
+};
+
+#endif /*__COMPACTMESH_H__*/
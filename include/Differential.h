@@ -0,0 +1,53 @@
+#ifndef DIFFERENTIAL_H
+#define DIFFERENTIAL_H
+#include "Quality.h"
+#include "Triangulation.h"
+#include "Validator.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Runs candidate meshing engines side by side with a reference engine (the
+// Triangulation split mesher with its original min-angle flips) on
+// generated point sets, and checks that every candidate mesh is valid,
+// Delaunay and of the same quality as the reference. A different mesh is only reported, not failed: the
+// Delaunay triangulation of cocircular points is not unique.
+class Differential {
+public:
+  // Meshes the points (x, y) into node coordinates and 0-based connectivity
+  typedef std::function<void(const std::vector<double> &,
+                             const std::vector<double> &,
+                             std::vector<double> &, std::vector<double> &,
+                             std::vector<unsigned> &)>
+      Engine;
+
+private:
+  Engine reference;
+  std::vector<std::string> names; // Candidate names
+  std::vector<Engine> engines;    // Candidates, in the order added
+  unsigned numThreads;
+  unsigned failures; // Candidate meshes that disagreed in the last run
+
+protected:
+  static void generate(unsigned, bool, std::vector<double> &,
+                       std::vector<double> &); // Grid, jittered or not
+  static double timed(const Engine &, const std::vector<double> &,
+                      const std::vector<double> &, std::vector<double> &,
+                      std::vector<double> &,
+                      std::vector<unsigned> &); // Runs engine, seconds
+
+public:
+  // Constructors
+  Differential(Engine, unsigned = 1); // Reference engine, threads
+  // Public methods
+  void addEngine(const std::string &, Engine); // Candidate to compare
+  std::string run(const std::vector<unsigned> &); // Report per grid size
+  unsigned numFailures() const;                   // From the last run
+};
+
+#endif /*__DIFFERENTIAL_H__*/
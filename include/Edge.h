@@ -1,6 +1,7 @@
 #ifndef EDGE_H
 #define EDGE_H
 #include "Node.h"
+#include "Point.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
@@ -14,7 +15,8 @@ class Node; // Forward declarations
 
 class Edge {
 private:
-  std::vector<double> edgeVec;
+  friend class Node;
+  Vec2d edgeVec;
   double length;
   Node *source;
   Node *sink;
@@ -24,14 +26,14 @@ protected:
 
 public:
   // Constructors
-  Edge() : edgeVec(0), length(0), source(nullptr), sink(nullptr){};
+  Edge() : edgeVec(), length(0), source(nullptr), sink(nullptr){};
   Edge(Node *, Node *);
   Edge(const Edge &); // Copy
   // Destructor
   ~Edge();
   // Operators
   Edge &operator=(const Edge &);           // Assignment
-  double operator%(std::vector<double> &); // "Projection" operator
+  double operator%(const Vec2d &);         // "Projection" operator
   double operator%(Edge &);                // "Projection" operator on edges
   double operator>(Edge *);                // "Angle" operator
   double operator[](int);                  // Indexing vector component
@@ -39,7 +41,7 @@ public:
   // Public methods
   bool crossesNode(Node *);              // Does this edge intersect node
   void split(Node *);                    // Split edge at node
-  std::vector<double> normalize() const; // Returns this edge normalized
+  Vec2d normalize() const;               // Returns this edge normalized
   double distanceTo(Node *);             // Perpendicular distance to node
   double getLength() const;              // Returns length of this edge
   Node *getSink() const;     // Returns which node this edge points to
@@ -0,0 +1,37 @@
+#ifndef EDGETABLE_H
+#define EDGETABLE_H
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Hash table of the undirected edges of a flat triangle connectivity array
+// (3 node indices per element). Every edge is found in expected O(1), so
+// the whole table, and the element neighbors derived from it, build in O(n).
+class EdgeTable {
+private:
+  std::unordered_map<unsigned long long, unsigned> index; // Key -> edge
+  std::vector<unsigned> edgeNodes; // 2 node indices per edge
+  std::vector<int> edgeElems;      // 2 elements per edge, -1 if none
+  std::vector<int> neighbors;      // 3 per element, across from vertex k
+  unsigned overfull;               // Edges with more than two elements
+
+public:
+  // Constructors
+  EdgeTable() : overfull(0){};
+  EdgeTable(const std::vector<unsigned> &);
+  // Public methods
+  static unsigned long long key(unsigned, unsigned); // Order-free edge key
+  unsigned numEdges() const;                  // Number of distinct edges
+  unsigned numBoundaryEdges() const;          // Edges with one element
+  unsigned numOverfullEdges() const;          // Non-manifold edges
+  int find(unsigned, unsigned) const;         // Edge joining nodes, or -1
+  unsigned edgeNode(unsigned, int) const;     // Node 0/1 of edge
+  int edgeElement(unsigned, int) const;       // Element 0/1 of edge, or -1
+  int neighbor(unsigned, int) const;          // Element across from vertex
+  const std::vector<int> &getNeighbors() const; // 3 per element
+};
+
+#endif /*__EDGETABLE_H__*/
@@ -3,11 +3,15 @@
 #include "Body.h"
 #include "Edge.h"
 #include "Node.h"
+#include "Predicates.h"
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <initializer_list>
 #include <iostream>
 #include <ostream>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 class Node;
@@ -25,6 +29,10 @@ private:
 protected:
   void getEdges();
   Element *splitAtEdge(Node *, Node *, Node *); // Split element at edge
+  void link(Element *,
+            std::initializer_list<Element *>); // Adjacent: outside, then new
+  static void replaceAcross(Element *, Element *,
+                            Element *); // Outside elem swaps old for new
 
 public:
   // Constructors
@@ -40,23 +48,25 @@ public:
   // Public methods
   std::vector<Element *> split(Node *);    // Split element by internal node
   unsigned getID() const;                  // Return elementID
-  std::vector<Node *> getVertices() const; // return vertices of this element
+  void setID(unsigned);                    // Renumbers this element
+  const std::vector<Node *> &getVertices() const; // Vertices of this element
   bool isVertex(Node *);                   // Is node a vertex of this element
   bool containsNode(Node *);               // Is node inside the element
   bool nodeIsOnEdge(Node *);               // Is node on edge of element
+  int sideOf(Node *, int);                 // Inside (1), on (0), out (-1) edge
+  Element *acrossEdge(int);                // Adjacent elem across edge k
+  Element *across(Node *, Node *);         // Adjacent elem sharing both nodes
   bool overlaps(Edge *);                  // Does edge overlap with edge of elem
   Node *findOppositeNode(Node *, Node *); // Finds node opposite edge
   bool shareEdge(Element *);              // Finds the edge these elems share
   std::vector<Node *> findSharedNodes(Element *); // Finds nodes they share
-  std::vector<Edge *> sourceNode(int);  // Finds edges in this elem from Node
+  std::pair<Edge *, Edge *> sourceNode(int) const; // Edges from vertex k
   void redefine(std::vector<Node *> &); // Redefines this element
-  std::vector<double> findCoordinates(Edge *, Edge *, Edge *);
-  std::vector<Element *> getAdjacent();       // Return adjacent
+  Vec2d findCoordinates(Edge *, Edge *, Edge *); // Coords in edge basis
+  const std::vector<Element *> &getAdjacent() const; // Return adjacent
   void setAdjacent(std::vector<Element *> &); // Update adjacent
-  void fixAdjacency(std::vector<Element *> &,
-                    std::vector<Element *> &); // Update adjacent
-  std::vector<Element *>
-  getFringe(std::vector<Element *> &); // get elems that border a set
+  void replaceAdjacent(Element *, Element *); // Swap one adjacent for another
+  std::size_t memoryBytes() const;     // Bytes held, including vectors
 };
 
 std::ostream &operator<<(std::ostream &, const Element *); // Out stream
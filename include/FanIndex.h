@@ -0,0 +1,43 @@
+#ifndef FANINDEX_H
+#define FANINDEX_H
+#include "Element.h"
+#include "Node.h"
+#include "Predicates.h"
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Elements around the nodes with the most edges, in angular order. Splits
+// join each new node to the corners of its element, so a grid pushed column
+// by column gathers fans of thousands of slivers at the domain corners, and
+// the next node is as many slivers away from the last one as there are
+// columns. A walk that reaches a fan looks up the sector holding the node
+// in O(log n) instead of crossing the slivers one by one.
+class FanIndex {
+private:
+  struct Order {
+    const Node *center;
+    bool operator()(const Node *, const Node *) const; // Counterclockwise
+  };
+  // Neighbor to the element counterclockwise of the edge to it, nullptr on
+  // the outside of a boundary node
+  typedef std::map<const Node *, Element *, Order> Fan;
+  std::unordered_map<const Node *, Fan> fans;
+  unsigned minEdges; // Nodes with this many edges get indexed
+
+protected:
+  void add(Fan &, Node *, Element *); // Record element in a node's fan
+  void build(Node *, Element *);      // Index a node from one of its elems
+
+public:
+  // Constructors
+  FanIndex(unsigned = 16);
+  // Public methods
+  void update(Element *);           // Element made or reshaped by a split
+  Element *sector(Node *, Node *) const; // Elem around node toward point
+};
+
+#endif /*__FANINDEX_H__*/
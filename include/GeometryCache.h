@@ -0,0 +1,47 @@
+#ifndef GEOMETRYCACHE_H
+#define GEOMETRYCACHE_H
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+// Per-element geometric factors of a flat P1 triangulation, stored as
+// separate arrays (structure of arrays): area, inverse Jacobian of the map
+// from the reference triangle, and the constant gradients of the three
+// shape functions. Built once; moving a node (Triangulation::moveNode
+// passes the move on) only marks the elements around it for recomputation.
+class GeometryCache {
+private:
+  std::vector<double> x, y;      // Node coordinates (owned copy)
+  std::vector<unsigned> conn;    // 3 node indices per element
+  std::vector<unsigned> nodeStart, incident; // Node to element (CSR)
+  std::vector<double> area;
+  std::vector<double> invJ[4];   // Row-major inverse Jacobian entries
+  std::vector<double> gradX[3];  // d(N_i)/dx for local node i
+  std::vector<double> gradY[3];  // d(N_i)/dy for local node i
+  std::vector<unsigned> dirty;   // Elements waiting for recomputation
+  std::vector<char> isDirty;
+
+protected:
+  void computeRange(unsigned, unsigned); // Elements [begin, end)
+
+public:
+  // Constructors
+  GeometryCache(){};
+  GeometryCache(const std::vector<double> &, const std::vector<double> &,
+                const std::vector<unsigned> &);
+  // Public methods
+  unsigned size() const;                        // Number of elements
+  void moveNode(unsigned, double, double);      // Move, invalidate around
+  void update();                                // Recompute invalid entries
+  unsigned numDirty() const;                    // Elements not up to date
+  const std::vector<double> &getArea() const;   // Element areas
+  const std::vector<double> &getInvJ(int) const;  // Inverse Jacobian entry
+  const std::vector<double> &getGradX(int) const; // Shape gradient x
+  const std::vector<double> &getGradY(int) const; // Shape gradient y
+  void write(std::ostream &) const;             // Raw arrays, in order
+};
+
+#endif /*__GEOMETRYCACHE_H__*/
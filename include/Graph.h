@@ -0,0 +1,35 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+#include "EdgeTable.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// Undirected graph in compressed sparse row form: the neighbors of vertex
+// i are adjacency[offsets[i]] up to adjacency[offsets[i + 1]], sorted.
+// Both graphs of a triangulation are built from an EdgeTable in O(n).
+class Graph {
+private:
+  std::vector<unsigned> offsets;
+  std::vector<unsigned> adjacency;
+
+public:
+  // Constructors
+  Graph() : offsets(1, 0){};
+  Graph(const std::vector<unsigned> &, const std::vector<unsigned> &);
+  // Public methods
+  static Graph nodeGraph(const std::vector<unsigned> &,
+                         unsigned);                  // Nodes joined by edges
+  static Graph dualGraph(const std::vector<unsigned> &); // Elements by edges
+  unsigned size() const;                                // Number of vertices
+  unsigned numEdges() const;                            // Undirected edges
+  unsigned degree(unsigned) const;                      // Neighbors of vertex
+  const std::vector<unsigned> &getOffsets() const;      // CSR row starts
+  const std::vector<unsigned> &getAdjacency() const;    // CSR neighbors
+  void printMetis(const char *) const; // METIS graph file, 1-based
+};
+
+#endif /*__GRAPH_H__*/
@@ -1,14 +1,30 @@
 #ifndef MESH_H
 #define MESH_H
+#include "Assembly.h"
 #include "Body.h"
+#include "CompactMesh.h"
+#include "Graph.h"
 #include "Node.h"
+#include "Ordering.h"
+#include "Partition.h"
+#include "Quality.h"
+#include "Renderer.h"
+#include "Trace.h"
 #include "Triangulation.h"
+#include "Validator.h"
 #include <algorithm>
+#include <chrono>
+#include <climits>
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
+#include <fstream>
 #include <iostream>
+#include <set>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -34,20 +50,56 @@ public:
   // Constructors
   Mesh() : body(0), nodes(0), T(nullptr), x_size(0), y_size(0){};
   Mesh(Body &);
-  Mesh(const Mesh &); // Copy
+  Mesh(const Mesh &); // Copy, with its own nodes and elements
+  Mesh(Mesh &&);      // Move
   // Destructor
   ~Mesh();
   // Operators
   Mesh &operator=(const Mesh &);     // Assignment
+  Mesh &operator=(Mesh &&);          // Move assignment
   Node *operator[](int);             // Index nodes
   const Node *operator[](int) const; // Index nodes const
   // Public methods
   void mesh();                  // Mesh input body
+  void mesh(const std::vector<double> &,
+            const std::vector<double> &); // Mesh given points in the body
+  std::string meshTiled(const char *,
+                        unsigned); // Stream tile by tile to file, report
+  void load(const char *);      // Read an existing .msh file
   void printMesh();             // Print mesh to stdout
   void printMesh(const char *); // Print mesh to file
+  void printBinary(const char *,
+                   bool = false); // Binary mesh, optionally with geometry
   unsigned size() const;        // Size of the mesh
   void Delaunay();              // Delaunay meshes the domain
+  void DelaunayMinAngle();      // Same, by the original min-angle flips
+  std::string DelaunayPriority(
+      const char *,
+      const Triangulation::FlipBudget &); // Best flips first, and report
   void randomize();             // Pseudo-randomly moves node points
+  void moveNode(unsigned, double, double,
+                GeometryCache * = nullptr); // Move node, invalidate cache
+  std::string quality(const char *,
+                      unsigned = 1); // Quality report, returns summary
+  Validator verify(unsigned = 1) const;           // Checks the triangulation
+  std::string renumber(const char *,
+                       const std::string &); // Reorders nodes, returns report
+  std::string reorder(const char *,
+                      const std::string &); // Curve-sorts output, and report
+  std::string partition(const char *, unsigned,
+                        bool = false); // Writes per-part files, and report
+  std::string assemble(const char *, const std::string &,
+                       unsigned = 1); // Writes stiffness matrix, and report
+  std::string color(const char *, const std::string &,
+                    unsigned = 1); // Colors elements, returns report
+  std::string printGraphs(const char *); // Node and dual graphs to file
+  std::string compact(const char *,
+                      bool = false); // Mesh in float/32-bit arrays, report
+  std::string render(const char *, const std::string &, const std::string &,
+                     unsigned = 1024,
+                     unsigned = 1); // Draws mesh to image, and report
+  uint64_t hash() const;                         // Canonical mesh hash
+  const Triangulation *getTriangulation() const; // Returns T
 };
 
 #endif /*__MESH_H__*/
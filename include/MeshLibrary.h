@@ -0,0 +1,27 @@
+#ifndef MESHLIBRARY_H
+#define MESHLIBRARY_H
+#include "Body.h"
+#include "Mesh.h"
+#include <vector>
+
+// In-process entry points of libdelaunaymesher. Nothing is read from or
+// written to files: the domain or points come in as numbers and the mesh
+// goes out as flat arrays, node coordinates plus 0-based connectivity
+// (3 node indices per element). Errors are thrown as exceptions, like the
+// rest of the mesher. Node and element counters are global, so calls must
+// not run concurrently.
+
+// Mesh the rectangle [xMin, xMax] x [yMin, yMax] on a grid no coarser than
+// xSize by ySize, as mesh-generator does for an input file
+void meshRectangle(double xMin, double yMin, double xMax, double yMax,
+                   double xSize, double ySize, std::vector<double> &x,
+                   std::vector<double> &y, std::vector<unsigned> &conn,
+                   bool delaunay = true);
+
+// Mesh the given points. Their bounding box becomes the domain, and its
+// corners are added as the first four nodes; repeated points are dropped.
+void meshPoints(const std::vector<double> &px, const std::vector<double> &py,
+                std::vector<double> &x, std::vector<double> &y,
+                std::vector<unsigned> &conn, bool delaunay = true);
+
+#endif /*__MESHLIBRARY_H__*/
@@ -2,11 +2,13 @@
 #define NODE_H
 #include "Body.h"
 #include "Edge.h"
+#include "Point.h"
 #include <assert.h>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <ostream>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #define INFTY 100000 // Some large number
@@ -18,40 +20,43 @@ private:
   friend class Body;
   static unsigned nextNodeID;
   unsigned nodeID;
-  std::vector<double> coords;
+  Point2d coords;
   std::vector<Edge *> edges;
+  std::unordered_map<Node *, unsigned> slots; // Sink to edges index, fans
 
 protected:
+  unsigned slotOf(Node *) const; // Index of edge to node, edges.size() if none
+  void index(Node *, unsigned);  // Record edge to node at index
 public:
   // Constructors
-  Node() : nodeID(nextNodeID), coords(0, 0), edges(0, nullptr) { nextNodeID++; }
+  Node() : nodeID(nextNodeID), coords(), edges(0, nullptr) { nextNodeID++; }
   Node(double, double);
-  Node(const Node &); // Copy
+  Node(const Node &) = delete; // Owns edges its neighbors point back along
   // Destructor
   virtual ~Node();
   // Operators
-  Node &operator=(const Node &);      // Assignment
+  Node &operator=(const Node &) = delete; // Not assignable either
   double operator[](int);             // Coordinate index
   const double operator[](int) const; // Coordinate index const
   // Public methods
   unsigned getID() const;        // Returns nodeID;
+  const Point2d &getPoint() const; // Returns coordinates
+  void setID(unsigned);          // Renumbers this node
+  void moveTo(double, double);   // New coordinates, edges both ways follow
   void connect(Node *);          // Connect this node to other node by edge
   void disconnect(Node *);       // Destroys edge that links nodes
   bool isConnected(Node *);      // Checks if node connected to another
+  Edge *edgeTo(Node *) const;    // Edge from this to other node, or nullptr
+  void redirect(Node *, Node *); // Edge to one node now points to another
   double distanceTo(Node *);     // Shortest distance to other node
   double distanceTo(Edge *);     // Perpendicular distance to edge
   bool isOnEdge(Node *, Node *); // Finds if this on lin interpolant of others
-  std::vector<Edge *>
+  const std::vector<Edge *> &
   sourceNode() const; // Returns all edges originating from this
+  std::size_t memoryBytes() const; // Bytes held, including owned edges
 };
 
 // overloaded operators in std relevant to this class
 std::ostream &operator<<(std::ostream &, const Node *); // Out stream
-std::vector<double> &operator*(std::vector<double> &v,
-                               double c); // scalar multiplication of vectors
-std::vector<double> &operator+(std::vector<double> &v1,
-                               std::vector<double> &v2); // Vector addition
-std::vector<double> &operator-(std::vector<double> &v1,
-                               std::vector<double> &v2); // Vector subtract
 
 #endif /*__NODE_H__*/
@@ -0,0 +1,50 @@
+#ifndef ORDERING_H
+#define ORDERING_H
+#include "Graph.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Node orderings of a triangulation's node graph, and space-filling curve
+// orderings of points. Orderings are returned as lists of old indices in
+// their new order, i.e. order[new] = old.
+class Ordering {
+private:
+  unsigned numNodes;
+  std::vector<unsigned> offsets;   // Row starts into adjacency (CSR)
+  std::vector<unsigned> adjacency; // Neighbors of each node
+
+protected:
+  unsigned degree(unsigned) const; // Number of neighbors
+  std::vector<int> levels(unsigned, const std::vector<bool> &) const;
+  unsigned peripheral(unsigned, const std::vector<bool> &,
+                      unsigned &) const; // Pseudo-peripheral node
+  std::vector<unsigned> ranks(const std::vector<unsigned> &) const;
+  static unsigned long long hilbertIndex(unsigned, unsigned);
+  static unsigned long long mortonIndex(unsigned, unsigned);
+
+public:
+  // Constructors
+  Ordering() : numNodes(0){};
+  Ordering(const std::vector<unsigned> &, unsigned); // Connectivity, nodes
+  // Public methods
+  std::vector<unsigned> identity() const;           // Current order
+  std::vector<unsigned> reverseCuthillMcKee() const; // Minimizes bandwidth
+  std::vector<unsigned> sloan() const;               // Minimizes profile
+  unsigned bandwidth(const std::vector<unsigned> &) const; // Max |i - j|
+  unsigned long long profile(const std::vector<unsigned> &) const; // Envelope
+  static std::vector<unsigned> curve(const std::vector<double> &,
+                                     const std::vector<double> &,
+                                     bool = true); // Hilbert (or Morton)
+  static double sweepTime(const std::vector<double> &,
+                          const std::vector<double> &,
+                          const std::vector<unsigned> &); // Assembly benchmark
+};
+
+#endif /*__ORDERING_H__*/
@@ -0,0 +1,48 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+#include "EdgeTable.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Splits the elements of a flat triangulation into k parts by recursive
+// coordinate (or inertial) bisection of element centroids, then lowers the
+// edge cut by greedily moving boundary elements between parts.
+class Partition {
+private:
+  unsigned numParts;
+  std::vector<double> cx, cy;   // Element centroids
+  std::vector<unsigned> conn;   // 3 node indices per element
+  std::vector<double> x, y;     // Node coordinates
+  std::vector<int> neighbors;   // Dual graph, 3 per element, -1 if none
+  std::vector<unsigned> parts;  // Part of each element
+  unsigned initialCut;          // Edge cut before refinement
+
+protected:
+  void bisect(std::vector<unsigned> &, unsigned, unsigned, unsigned, unsigned,
+              bool); // Recursive bisection of elements [begin, end)
+  void refine(double); // Greedy boundary refinement within a balance bound
+
+public:
+  // Constructors
+  Partition() : numParts(0), initialCut(0){};
+  Partition(const std::vector<double> &, const std::vector<double> &,
+            const std::vector<unsigned> &, unsigned, bool = false);
+  // Public methods
+  unsigned size() const;                       // Number of parts
+  const std::vector<unsigned> &getParts() const; // Part of each element
+  unsigned edgeCut() const;                    // Dual edges between parts
+  unsigned edgeCutBeforeRefinement() const;    // Edge cut of bisection only
+  std::vector<unsigned> partSizes() const;     // Elements per part
+  void write(const std::string &, const std::vector<unsigned> &,
+             const std::vector<unsigned> &) const; // Per-part files
+};
+
+#endif /*__PARTITION_H__*/
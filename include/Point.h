@@ -0,0 +1,100 @@
+#ifndef POINT_H
+#define POINT_H
+#include <cmath>
+#include <cstdlib>
+
+// Fixed-size geometry kernel. Components live inside the object, so a
+// point or vector never touches the heap, and the loops over D have a
+// compile-time trip count the compiler can unroll and vectorize.
+
+template <typename T, unsigned D> class Vec {
+private:
+  T c[D];
+
+public:
+  // Constructors
+  constexpr Vec() : c{} {}
+  constexpr Vec(T x, T y) : c{x, y} {} // 2D vectors only
+  // Operators
+  T &operator[](unsigned i) { return c[i]; } // Component
+  constexpr const T &operator[](unsigned i) const { return c[i]; }
+  Vec operator+(const Vec &rhs) const {
+    Vec ans;
+    for (unsigned i = 0; i < D; i++) {
+      ans.c[i] = c[i] + rhs.c[i];
+    }
+    return ans;
+  }
+  Vec operator-(const Vec &rhs) const {
+    Vec ans;
+    for (unsigned i = 0; i < D; i++) {
+      ans.c[i] = c[i] - rhs.c[i];
+    }
+    return ans;
+  }
+  Vec operator*(T s) const {
+    Vec ans;
+    for (unsigned i = 0; i < D; i++) {
+      ans.c[i] = c[i] * s;
+    }
+    return ans;
+  }
+  Vec operator/(T s) const {
+    Vec ans;
+    for (unsigned i = 0; i < D; i++) {
+      ans.c[i] = c[i] / s;
+    }
+    return ans;
+  }
+  // Public methods
+  static constexpr unsigned size() { return D; } // Dimension
+  T dot(const Vec &rhs) const {                  // Inner product
+    T ans = 0;
+    for (unsigned i = 0; i < D; i++) {
+      ans += c[i] * rhs.c[i];
+    }
+    return ans;
+  }
+  T lengthSq() const { return dot(*this); }           // Squared length
+  T length() const { return std::sqrt(lengthSq()); }  // Euclidean length
+  Vec normalized() const { return *this / length(); } // Unit vector
+};
+
+template <typename T, unsigned D> class Point {
+private:
+  T c[D];
+
+public:
+  // Constructors
+  constexpr Point() : c{} {}
+  constexpr Point(T x, T y) : c{x, y} {} // 2D points only
+  // Operators
+  T &operator[](unsigned i) { return c[i]; } // Coordinate
+  constexpr const T &operator[](unsigned i) const { return c[i]; }
+  Vec<T, D> operator-(const Point &rhs) const { // Vector from rhs to this
+    Vec<T, D> ans;
+    for (unsigned i = 0; i < D; i++) {
+      ans[i] = c[i] - rhs.c[i];
+    }
+    return ans;
+  }
+  Point operator+(const Vec<T, D> &rhs) const { // Translate
+    Point ans;
+    for (unsigned i = 0; i < D; i++) {
+      ans.c[i] = c[i] + rhs[i];
+    }
+    return ans;
+  }
+  // Public methods
+  static constexpr unsigned size() { return D; } // Dimension
+};
+
+// Z component of the cross product of two 2D vectors
+template <typename T> T cross(const Vec<T, 2> &a, const Vec<T, 2> &b) {
+  return a[0] * b[1] - a[1] * b[0];
+}
+
+typedef Vec<double, 2> Vec2d;
+typedef Point<double, 2> Point2d;
+
+#endif /*__POINT_H__*/
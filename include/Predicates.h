@@ -0,0 +1,39 @@
+#ifndef PREDICATES_H
+#define PREDICATES_H
+#include "Point.h"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// Adaptive geometric predicates after Shewchuk, "Adaptive Precision
+// Floating-Point Arithmetic and Fast Robust Geometric Predicates" (1997).
+// Both first evaluate the determinant in plain floating point and only fall
+// back to exact expansion arithmetic when the result is within the error
+// bound of zero, so the sign they return is always correct.
+
+// Positive if a, b, c are in counterclockwise order, negative if clockwise,
+// zero if collinear
+double orient2d(double ax, double ay, double bx, double by, double cx,
+                double cy);
+
+// Positive if d lies inside the circle through a, b, c (a, b, c in
+// counterclockwise order; sign flips for clockwise), zero if cocircular
+double incircle(double ax, double ay, double bx, double by, double cx,
+                double cy, double dx, double dy);
+
+// Whether edge s0-s1, shared by triangles (s0, s1, op1) and (s1, s0, op2)
+// of a strictly convex quad, is locally Delaunay: op2 not inside the circle
+// through s0, s1, op1. Points and ids come in that order. Cocircular ties
+// are broken by symbolic perturbation, so the Delaunay mesh is unique
+bool isLocallyDelaunay(const Point2d[4], const unsigned[4]);
+
+inline double orient2d(const Point2d &a, const Point2d &b, const Point2d &c) {
+  return orient2d(a[0], a[1], b[0], b[1], c[0], c[1]);
+}
+
+inline double incircle(const Point2d &a, const Point2d &b, const Point2d &c,
+                       const Point2d &d) {
+  return incircle(a[0], a[1], b[0], b[1], c[0], c[1], d[0], d[1]);
+}
+
+#endif /*__PREDICATES_H__*/
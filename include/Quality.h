@@ -0,0 +1,55 @@
+#ifndef QUALITY_H
+#define QUALITY_H
+#include "Triangulation.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Triangulation; // Forward declaration
+
+class Quality {
+public:
+  enum Metric { MIN_ANGLE, ASPECT_RATIO, AREA, EDGE_RATIO };
+
+private:
+  // Per-element metrics, stored as separate arrays (structure of arrays)
+  std::vector<double> minAngle;    // Smallest interior angle in degrees
+  std::vector<double> aspectRatio; // Circumradius over twice the inradius
+  std::vector<double> area;        // Element area
+  std::vector<double> edgeRatio;   // Longest over shortest edge
+  unsigned numThreads;
+
+protected:
+  void compute(const std::vector<double> &, const std::vector<double> &,
+               const std::vector<unsigned> &); // Fill all metric arrays
+  void computeRange(const double *, const double *, const double *,
+                    const double *, const double *, const double *, unsigned,
+                    unsigned); // Kernel over elements [begin, end)
+
+public:
+  // Constructors
+  Quality() : numThreads(1){};
+  Quality(const Triangulation &, unsigned = 1);
+  Quality(const std::vector<double> &, const std::vector<double> &,
+          const std::vector<unsigned> &, unsigned = 1); // From flat arrays
+  // Public methods
+  unsigned size() const;                               // Number of elements
+  const std::vector<double> &getMetric(Metric) const;  // Per-element values
+  double min(Metric) const;                            // Smallest value
+  double max(Metric) const;                            // Largest value
+  double mean(Metric) const;                           // Average value
+  std::vector<unsigned> histogram(Metric, double, double,
+                                  unsigned) const; // Counts in [lo, hi)
+  std::string summary() const;                     // One line summary
+  void printReport(const char *) const;            // Histograms to file
+};
+
+#endif /*__QUALITY_H__*/
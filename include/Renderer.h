@@ -0,0 +1,50 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Draws a mesh without Python or a display: elements are filled by a
+// scanline rasterizer into an RGB image, optionally shaded by a per-element
+// value, and their edges drawn on top. Images are written as PPM or as an
+// uncompressed PNG; SVG output writes the elements as polygons instead.
+class Renderer {
+private:
+  std::vector<double> x, y;           // Node coordinates
+  std::vector<unsigned> conn;         // 3 node indices per element
+  std::vector<double> value;          // Shade per element, empty for none
+  double bad, good;                   // Values shaded red and green
+  double scale, xMin, yMin;           // Mesh to pixel transform
+  unsigned width, height, margin;     // Image size in pixels
+  std::vector<unsigned char> pixels;  // RGB, rows top to bottom
+
+protected:
+  void toPixel(unsigned, double &, double &) const; // Node to pixel
+  void elementColor(unsigned, unsigned char *) const; // Fill color
+  void fillTriangle(unsigned, const unsigned char *); // Scanline fill
+  void drawLine(double, double, double, double);      // Black edge
+
+public:
+  // Constructors
+  Renderer(const std::vector<double> &, const std::vector<double> &,
+           const std::vector<unsigned> &,
+           unsigned = 1024); // Longest image side in pixels
+  // Public methods
+  unsigned getWidth() const;  // Image width
+  unsigned getHeight() const; // Image height
+  void shade(const std::vector<double> &, double,
+             double); // Values, and those drawn red and green
+  void rasterize(bool = true); // Fill elements, with or without edges
+  bool edgesVisible() const;   // Elements are large enough to outline
+  void printPPM(const char *) const; // Binary PPM (P6)
+  void printPNG(const char *) const; // PNG, stored without compression
+  void printSVG(const char *) const; // Polygons, one per element
+};
+
+#endif /*__RENDERER_H__*/
@@ -0,0 +1,60 @@
+#ifndef TRACE_H
+#define TRACE_H
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Timeline of where the mesher spends its time, written in the Chrome
+// trace-event format (chrome://tracing, Perfetto). Spans are recorded
+// only once tracing is enabled; a disabled Span costs one flag test.
+// Each span is tagged with the thread that ran it. Spans also mark the
+// current phase of their thread, for per-phase allocation counts.
+class Trace {
+private:
+  struct Event {
+    std::string name, category, file;
+    double start, duration; // Microseconds since tracing was enabled
+    unsigned thread;        // Small index, 0 for the first thread seen
+  };
+  static bool enabled;
+  static bool tracking;                  // Keep the current phase up to date
+  static thread_local const char *phase; // Innermost open span on the thread
+  static std::chrono::steady_clock::time_point origin;
+  static std::mutex lock;
+  static std::vector<Event> events;
+  static std::map<std::thread::id, unsigned> threads;
+
+protected:
+  static double now();            // Microseconds since origin
+  static unsigned threadIndex();  // Index of the calling thread, locked
+  static std::string escape(const std::string &); // JSON string contents
+
+public:
+  // Records the time from construction to destruction as one span
+  class Span {
+  private:
+    const char *name, *category;
+    const char *parent; // Phase to restore when the span closes
+    std::string file; // Input file the span belongs to, if any
+    double start;
+    bool active;
+
+  public:
+    Span(const char *, const char * = "mesh", const std::string & = "");
+    ~Span();
+  };
+  static void enable();               // Start recording, clears events
+  static bool isEnabled();            // Are spans being recorded
+  static void trackPhases();          // Follow spans without recording
+  static const char *currentPhase();  // Innermost span name, or nullptr
+  static void write(const char *);    // Trace-event JSON to file
+};
+
+#endif /*__TRACE_H__*/
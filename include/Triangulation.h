@@ -1,15 +1,26 @@
 #ifndef TRIANGULATION_H
 #define TRIANGULATION_H
+#include "Coloring.h"
 #include "Edge.h"
+#include "EdgeTable.h"
 #include "Element.h"
+#include "FanIndex.h"
+#include "GeometryCache.h"
 #include "Node.h"
+#include "Predicates.h"
 #include <algorithm>
+#include <array>
 #include <assert.h>
+#include <cstdint>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <chrono>
+#include <queue>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -17,43 +28,92 @@ class Edges;
 class Node; // Forward declarations
 
 class Triangulation {
+public:
+  enum FlipStatus { FLIPPABLE, NOT_CONVEX, COLLINEAR }; // checkFlip result
+  struct FlipStats {
+    unsigned tested = 0;   // Element pairs evaluated
+    unsigned rejected = 0; // Not convex or collinear, so cannot flip
+    unsigned flipped = 0;  // Flips of edges failing the incircle test
+    unsigned thrown = 0;   // Exceptions raised while evaluating flips
+  };
+  struct FlipBudget {
+    double minAngle = 0; // Stop once no element angle is below (degrees)
+    double seconds = 0;  // Wall-clock limit, 0 for none
+    unsigned flips = 0;  // Flip limit, 0 for none
+  };
+  enum StopReason { CONVERGED, REACHED_ANGLE, OUT_OF_TIME, OUT_OF_FLIPS };
+
 private:
   std::vector<Node *> nodes;
   std::vector<Element *> elements;
   bool DelaunayFlag;
+  bool budgetFlag; // Priority flips stopped by a budget before converging
   bool randFlag;
-
-  class overlappingEdge : std::exception {
-    const char *what() { return "Edges in element overlap"; };
-  };
+  FlipStats flips;
 
 protected:
-  void push(Node *);        // Adds node to mesh
+  void push(Node *, FanIndex &); // Adds node to mesh
+  Element *locate(Node *,
+                  const FanIndex &); // Element holding node, or nullptr
   void buildOutsideEdges(); // connects all the outside nodes, i.e. nodes[1-4]
   void addFirstNode();      // First node creates first elements
   void triangulate();       // Builds elements from nodes
   double minimumInteriorAngle(Element *, Element *); // Finds min inter'r angle
-  std::vector<std::vector<Node *>> tryDelaunay(Element *, Element *);
+  FlipStatus tryDelaunay(Element *, Element *,
+                         std::vector<std::vector<Node *>> &); // Flip diagonal
+  FlipStatus checkFlip(Element *, Element *, Node *&, Node *&, Node *&,
+                       Node *&); // Shared, then opposite nodes; no changes
+  void applyFlip(Element *, Element *,
+                 std::vector<std::vector<Node *>> &); // Redefine, rewire
+  bool isLegal(Node *, Node *, Node *,
+               Node *) const; // Keep shared edge? Exact, ties perturbed
   void buildDiagonal(); // Special case if number of nodes == 4
   void initAdjacents(); // Finds all the adjacent elements to all current elems
 
 public:
   // Constructors
   Triangulation()
-      : nodes(0), elements(0), DelaunayFlag(false), randFlag(false) {}
+      : nodes(0), elements(0), DelaunayFlag(false), budgetFlag(false),
+        randFlag(false) {}
   Triangulation(std::vector<Node *> &);
-  Triangulation(const Triangulation &); // Copy
+  Triangulation(std::vector<Node *> &,
+                const std::vector<unsigned> &); // From given connectivity
+  Triangulation(const Triangulation &); // Copy, over the same nodes
+  Triangulation(const Triangulation &,
+                const std::vector<Node *> &); // Copy onto matching new nodes
+  Triangulation(Triangulation &&);            // Move
   // Destructor
   ~Triangulation();
   // Operators
   Triangulation &operator=(const Triangulation &); // Assignment
+  Triangulation &operator=(Triangulation &&);      // Move assignment
   // Public methods
-  std::vector<Node *> getNodes() const;   // Returns nodes in this
-  std::vector<Element *> getElem() const; // Returns elements in this
+  const std::vector<Node *> &getNodes() const;   // Returns nodes in this
+  const std::vector<Element *> &getElem() const; // Returns elements in this
   void printMesh();                       // Print mesh to stdout
   void printMesh(const char *);           // Print mesh to file
+  void printBinary(const char *,
+                   const GeometryCache * = nullptr); // Binary mesh to file
+  std::string fileRoot(const char *) const; // Output name without extension
+  void getArrays(std::vector<double> &, std::vector<double> &,
+                 std::vector<unsigned> &) const; // Flat coords/connectivity
+  void moveNode(unsigned, double, double,
+                GeometryCache * = nullptr); // Node i (getArrays order) moves
   void Delaunay();                        // Delaunay-ifies the mesh
+  void DelaunayMinAngle(); // Same, by the original min-angle flip rule
+  StopReason DelaunayPriority(const FlipBudget &); // Best flips first
+  void renumberNodes(const std::vector<unsigned> &); // Reorder, renumber
+  void renumberElements(const std::vector<unsigned> &); // Reorder, renumber
+  Coloring color(Coloring::Method = Coloring::GREEDY,
+                 unsigned = 1) const; // Node-sharing element coloring
   bool isDelaunay() const;                // Has Delaunay triang been performed
+  const FlipStats &getFlipStats() const;  // Counts from Delaunay()
+  std::size_t memoryBytes() const;        // Bytes held by nodes, elements
+  std::string flipSummary() const;        // One line report of the counts
+  uint64_t canonicalHash() const;         // Same for any node/element order
+  static uint64_t canonicalHash(const std::vector<double> &,
+                                const std::vector<double> &,
+                                const std::vector<unsigned> &); // Of arrays
   void setRandFlag(bool);                 // Set if nodes been randomized
   bool isRandom() const;                  // Have nodes been randomized
 };
@@ -0,0 +1,57 @@
+#ifndef VALIDATOR_H
+#define VALIDATOR_H
+#include "EdgeTable.h"
+#include "Element.h"
+#include "Predicates.h"
+#include "Trace.h"
+#include "Triangulation.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class Triangulation; // Forward declaration
+
+class Validator {
+private:
+  unsigned numThreads;
+  unsigned numNodes, numEdges, numElements;
+  unsigned degenerate;   // Elements with zero area, or malformed
+  unsigned malformed;    // Elements with a node out of range or repeated
+  unsigned folded;       // Interior edges with both opposite nodes on a side
+  unsigned overfull;     // Edges shared by more than two elements
+  unsigned badAdjacency; // Elements whose adjacent list is wrong
+  unsigned nonDelaunay;  // Interior edges failing the incircle test
+
+protected:
+  static unsigned keepSound(const std::vector<unsigned> &, std::size_t,
+                            std::vector<unsigned> &); // Drop malformed elems
+  void check(const std::vector<double> &, const std::vector<double> &,
+             const std::vector<unsigned> &, const EdgeTable &);
+  void checkEdges(const std::vector<double> &, const std::vector<double> &,
+                  const std::vector<unsigned> &, const EdgeTable &, unsigned,
+                  unsigned, unsigned &, unsigned &, unsigned &) const;
+
+public:
+  // Constructors
+  Validator()
+      : numThreads(1), numNodes(0), numEdges(0), numElements(0),
+        degenerate(0), malformed(0), folded(0), overfull(0), badAdjacency(0),
+        nonDelaunay(0){};
+  Validator(const Triangulation &, unsigned = 1);
+  Validator(const std::vector<double> &, const std::vector<double> &,
+            const std::vector<unsigned> &,
+            unsigned = 1); // From flat arrays, adjacency not checked
+  // Public methods
+  int eulerCharacteristic() const; // V - E + F, 1 for a disk
+  unsigned numMalformed() const;   // Elements skipped as malformed
+  bool isValid() const;            // Sound topology and geometry
+  bool isDelaunay() const;         // Every interior edge locally Delaunay
+  std::string summary() const;     // One line report
+};
+
+#endif /*__VALIDATOR_H__*/
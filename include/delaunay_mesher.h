@@ -0,0 +1,42 @@
+#ifndef DELAUNAY_MESHER_H
+#define DELAUNAY_MESHER_H
+#include <stddef.h>
+#include <stdint.h>
+
+/* Stable C interface of libdelaunaymesher. A dm_mesh is opaque and owns
+ * its arrays until dm_free. Functions that can fail return DM_OK or
+ * DM_ERROR; dm_last_error then describes the failure. Calls must not run
+ * concurrently. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DM_OK 0
+#define DM_ERROR 1
+
+typedef struct dm_mesh dm_mesh;
+
+/* Mesh the rectangle [x_min, x_max] x [y_min, y_max] on a grid no coarser
+ * than x_size by y_size */
+int dm_mesh_rectangle(double x_min, double y_min, double x_max, double y_max,
+                      double x_size, double y_size, int delaunay,
+                      dm_mesh **out);
+
+/* Mesh n points; their bounding box corners become the first four nodes */
+int dm_mesh_points(const double *x, const double *y, size_t n, int delaunay,
+                   dm_mesh **out);
+
+size_t dm_num_nodes(const dm_mesh *mesh);
+size_t dm_num_elements(const dm_mesh *mesh);
+const double *dm_x(const dm_mesh *mesh);                 /* Node x */
+const double *dm_y(const dm_mesh *mesh);                 /* Node y */
+const uint32_t *dm_connectivity(const dm_mesh *mesh);    /* 3 per element */
+void dm_free(dm_mesh *mesh);
+const char *dm_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*__DELAUNAY_MESHER_H__*/
@@ -0,0 +1,242 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "../include/Mesh.h"
+#include "../include/MeshLibrary.h"
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+// Python bindings of libdelaunaymesher. Meshes come back as a tuple
+// (x, y, triangles) of read-only arrays that own their storage and export
+// it through the buffer protocol, so numpy.asarray or memoryview wrap them
+// without copying. triangles is n x 3 of 0-based node indices.
+
+typedef struct {
+  PyObject_HEAD
+  std::vector<double> *doubles;   // Either coordinates
+  std::vector<uint32_t> *indices; // or connectivity
+  int ndim;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+} ArrayObject;
+
+static void Array_dealloc(PyObject *obj) {
+  ArrayObject *self = (ArrayObject *)obj;
+  delete self->doubles;
+  delete self->indices;
+  Py_TYPE(obj)->tp_free(obj);
+}
+
+static int Array_getbuffer(PyObject *obj, Py_buffer *view, int flags) {
+  ArrayObject *self = (ArrayObject *)obj;
+  if (flags & PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "Mesh arrays are read-only");
+    view->obj = NULL;
+    return -1;
+  }
+  bool isDouble = self->doubles != NULL;
+  view->obj = obj;
+  Py_INCREF(obj);
+  view->buf = isDouble ? (void *)self->doubles->data()
+                       : (void *)self->indices->data();
+  view->itemsize = isDouble ? sizeof(double) : sizeof(uint32_t);
+  view->len = self->shape[0] * (self->ndim == 2 ? self->shape[1] : 1) *
+              view->itemsize;
+  view->readonly = 1;
+  view->format = NULL;
+  if (flags & PyBUF_FORMAT) {
+    view->format = (char *)(isDouble ? "d" : "I");
+  }
+  view->ndim = self->ndim;
+  view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+  view->strides = (flags & PyBUF_STRIDES) ? self->strides : NULL;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+  return 0;
+}
+
+static Py_ssize_t Array_length(PyObject *obj) {
+  return ((ArrayObject *)obj)->shape[0];
+}
+
+static PyBufferProcs Array_buffer = {Array_getbuffer, NULL};
+
+static PySequenceMethods Array_sequence = {Array_length};
+
+static PyTypeObject ArrayType = {PyVarObject_HEAD_INIT(NULL, 0)};
+
+static PyObject *newArray(std::vector<double> &values) {
+  ArrayObject *self = PyObject_New(ArrayObject, &ArrayType);
+  if (self == NULL) {
+    return NULL;
+  }
+  self->doubles = new std::vector<double>();
+  self->doubles->swap(values);
+  self->indices = NULL;
+  self->ndim = 1;
+  self->shape[0] = self->doubles->size();
+  self->shape[1] = 1;
+  self->strides[0] = sizeof(double);
+  self->strides[1] = 0;
+  return (PyObject *)self;
+}
+
+static PyObject *newArray(const std::vector<unsigned> &conn) {
+  ArrayObject *self = PyObject_New(ArrayObject, &ArrayType);
+  if (self == NULL) {
+    return NULL;
+  }
+  self->doubles = NULL;
+  self->indices = new std::vector<uint32_t>(conn.begin(), conn.end());
+  self->ndim = 2;
+  self->shape[0] = conn.size() / 3;
+  self->shape[1] = 3;
+  self->strides[0] = 3 * sizeof(uint32_t);
+  self->strides[1] = sizeof(uint32_t);
+  return (PyObject *)self;
+}
+
+static PyObject *meshTuple(std::vector<double> &x, std::vector<double> &y,
+                           const std::vector<unsigned> &conn) {
+  PyObject *px = newArray(x);
+  PyObject *py = newArray(y);
+  PyObject *pc = newArray(conn);
+  if (px == NULL || py == NULL || pc == NULL) {
+    Py_XDECREF(px);
+    Py_XDECREF(py);
+    Py_XDECREF(pc);
+    return NULL;
+  }
+  return Py_BuildValue("(NNN)", px, py, pc);
+}
+
+static PyObject *raise(const char *what) {
+  PyErr_SetString(PyExc_RuntimeError, what);
+  return NULL;
+}
+
+static bool toDoubles(PyObject *obj, std::vector<double> &out) {
+  // Contiguous float64 buffers (numpy arrays) are read directly, anything
+  // else is treated as a sequence of numbers
+  Py_buffer view;
+  if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) ==
+      0) {
+    bool ok = view.format != NULL && std::string(view.format) == "d";
+    if (ok) {
+      const double *data = (const double *)view.buf;
+      out.assign(data, data + view.len / sizeof(double));
+    }
+    PyBuffer_Release(&view);
+    if (ok) {
+      return true;
+    }
+  }
+  PyErr_Clear();
+  PyObject *seq = PySequence_Fast(obj, "Points must be a sequence of numbers");
+  if (seq == NULL) {
+    return false;
+  }
+  Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+  out.resize(n);
+  for (Py_ssize_t i = 0; i < n; i++) {
+    out[i] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq, i));
+  }
+  Py_DECREF(seq);
+  return !PyErr_Occurred();
+}
+
+static PyObject *dm_load(PyObject *, PyObject *args) {
+  const char *fileName;
+  if (!PyArg_ParseTuple(args, "s", &fileName)) {
+    return NULL;
+  }
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  try {
+    Mesh meshedBody;
+    meshedBody.load(fileName);
+    meshedBody.getTriangulation()->getArrays(x, y, conn);
+  } catch (const std::exception &e) {
+    return raise(e.what());
+  } catch (...) {
+    return raise("Unknown error\n");
+  }
+  return meshTuple(x, y, conn);
+}
+
+static PyObject *dm_mesh_rectangle(PyObject *, PyObject *args,
+                                   PyObject *kwargs) {
+  static const char *keywords[] = {"x_min",  "y_min",  "x_max",    "y_max",
+                                   "x_size", "y_size", "delaunay", NULL};
+  double xMin, yMin, xMax, yMax, xSize, ySize;
+  int delaunay = 1;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "dddddd|p", (char **)keywords,
+                                   &xMin, &yMin, &xMax, &yMax, &xSize, &ySize,
+                                   &delaunay)) {
+    return NULL;
+  }
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  try {
+    meshRectangle(xMin, yMin, xMax, yMax, xSize, ySize, x, y, conn,
+                  delaunay != 0);
+  } catch (const std::exception &e) {
+    return raise(e.what());
+  } catch (...) {
+    return raise("Unknown error\n");
+  }
+  return meshTuple(x, y, conn);
+}
+
+static PyObject *dm_mesh_points(PyObject *, PyObject *args, PyObject *kwargs) {
+  static const char *keywords[] = {"x", "y", "delaunay", NULL};
+  PyObject *xObj, *yObj;
+  int delaunay = 1;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|p", (char **)keywords,
+                                   &xObj, &yObj, &delaunay)) {
+    return NULL;
+  }
+  std::vector<double> px, py, x, y;
+  std::vector<unsigned> conn;
+  if (!toDoubles(xObj, px) || !toDoubles(yObj, py)) {
+    return NULL;
+  }
+  try {
+    meshPoints(px, py, x, y, conn, delaunay != 0);
+  } catch (const std::exception &e) {
+    return raise(e.what());
+  } catch (...) {
+    return raise("Unknown error\n");
+  }
+  return meshTuple(x, y, conn);
+}
+
+static PyMethodDef methods[] = {
+    {"load", dm_load, METH_VARARGS,
+     "load(path) -> (x, y, triangles) read from a .msh file"},
+    {"mesh_rectangle", (PyCFunction)(void (*)(void))dm_mesh_rectangle,
+     METH_VARARGS | METH_KEYWORDS,
+     "mesh_rectangle(x_min, y_min, x_max, y_max, x_size, y_size, "
+     "delaunay=True) -> (x, y, triangles)"},
+    {"mesh_points", (PyCFunction)(void (*)(void))dm_mesh_points,
+     METH_VARARGS | METH_KEYWORDS,
+     "mesh_points(x, y, delaunay=True) -> (x, y, triangles)"},
+    {NULL, NULL, 0, NULL}};
+
+static PyModuleDef module = {PyModuleDef_HEAD_INIT, "delaunaymesher",
+                             "In-process Delaunay mesher", -1, methods};
+
+PyMODINIT_FUNC PyInit_delaunaymesher(void) {
+  ArrayType.tp_name = "delaunaymesher.Array";
+  ArrayType.tp_basicsize = sizeof(ArrayObject);
+  ArrayType.tp_dealloc = Array_dealloc;
+  ArrayType.tp_as_buffer = &Array_buffer;
+  ArrayType.tp_as_sequence = &Array_sequence;
+  ArrayType.tp_flags = Py_TPFLAGS_DEFAULT;
+  ArrayType.tp_doc = "Read-only mesh array, exported via the buffer protocol";
+  if (PyType_Ready(&ArrayType) < 0) {
+    return NULL;
+  }
+  return PyModule_Create(&module);
+}
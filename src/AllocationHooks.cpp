@@ -0,0 +1,46 @@
+#include "../include/Allocations.h"
+#include <cstdlib>
+#include <new>
+
+// Global allocation functions that report to Allocations. Only the
+// mesh-generator executable links this file.
+
+void *operator new(std::size_t size) {
+  void *p = std::malloc(size > 0 ? size : 1);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  Allocations::allocated(size);
+  return p;
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  void *p = std::malloc(size > 0 ? size : 1);
+  if (p != nullptr) {
+    Allocations::allocated(size);
+  }
+  return p;
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &t) noexcept {
+  return operator new(size, t);
+}
+
+void operator delete(void *p) noexcept {
+  if (p != nullptr) {
+    Allocations::freed();
+    std::free(p);
+  }
+}
+
+void operator delete[](void *p) noexcept { operator delete(p); }
+
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+  operator delete(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+  operator delete(p);
+}
@@ -0,0 +1,86 @@
+#include "../include/Allocations.h"
+
+std::atomic<bool> Allocations::enabled(false);
+std::atomic<unsigned> Allocations::numPhases(1);
+const char *Allocations::names[Allocations::maxPhases] = {"(no phase)"};
+std::atomic<unsigned long long> Allocations::counts[Allocations::maxPhases];
+std::atomic<unsigned long long> Allocations::bytes[Allocations::maxPhases];
+std::atomic<unsigned long long> Allocations::frees[Allocations::maxPhases];
+std::mutex Allocations::lock;
+
+// Public methods
+void Allocations::enable() {
+  for (unsigned i = 0; i < maxPhases; i++) {
+    counts[i] = 0;
+    bytes[i] = 0;
+    frees[i] = 0;
+  }
+  Trace::trackPhases();
+  enabled = true;
+}
+
+void Allocations::disable() { enabled = false; }
+
+void Allocations::allocated(std::size_t size) {
+  if (!enabled) {
+    return;
+  }
+  unsigned i = phaseIndex(Trace::currentPhase());
+  counts[i]++;
+  bytes[i] += size;
+}
+
+void Allocations::freed() {
+  if (!enabled) {
+    return;
+  }
+  frees[phaseIndex(Trace::currentPhase())]++;
+}
+
+std::string Allocations::report() {
+  // Building the report allocates too, so counting stops first
+  bool wasEnabled = enabled.exchange(false);
+  std::vector<std::pair<unsigned long long, unsigned>> order;
+  for (unsigned i = 0; i < numPhases; i++) {
+    if (counts[i] > 0 || frees[i] > 0) {
+      order.push_back(std::make_pair(counts[i].load(), i));
+    }
+  }
+  std::sort(order.rbegin(), order.rend());
+  std::ostringstream s;
+  s << "allocations per phase (count, bytes, frees):";
+  for (unsigned j = 0; j < order.size(); j++) {
+    unsigned i = order[j].second;
+    s << "\n  " << names[i] << ": " << counts[i] << ", " << bytes[i] << ", "
+      << frees[i];
+  }
+  enabled = wasEnabled;
+  return s.str();
+}
+
+// Protected methods
+unsigned Allocations::phaseIndex(const char *phase) {
+  // Span names are string literals, so the pointer usually matches
+  if (phase == nullptr) {
+    return 0;
+  }
+  unsigned n = numPhases;
+  for (unsigned i = 1; i < n; i++) {
+    if (names[i] == phase || strcmp(names[i], phase) == 0) {
+      return i;
+    }
+  }
+  std::lock_guard<std::mutex> guard(lock);
+  n = numPhases;
+  for (unsigned i = 1; i < n; i++) {
+    if (strcmp(names[i], phase) == 0) {
+      return i;
+    }
+  }
+  if (n == maxPhases) {
+    return 0;
+  }
+  names[n] = phase;
+  numPhases = n + 1;
+  return n;
+}
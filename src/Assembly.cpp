@@ -0,0 +1,207 @@
+#include "../include/Assembly.h"
+
+// Constructors
+Assembly::Assembly(const std::vector<double> &xIn,
+                   const std::vector<double> &yIn,
+                   const std::vector<unsigned> &connIn, Problem which) {
+  x = xIn;
+  y = yIn;
+  conn = connIn;
+  problem = which;
+  dofsPerNode = problem == ELASTICITY ? 2 : 1;
+  coloring = Coloring(conn, x.size());
+  buildPattern();
+}
+
+// Public methods
+void Assembly::assemble(unsigned threads) {
+  std::fill(values.begin(), values.end(), 0);
+  std::fill(rhs.begin(), rhs.end(), 0);
+  threads = std::max(threads, 1u);
+  for (unsigned c = 0; c < coloring.numColors(); c++) {
+    // Elements of one color share no node, so their scatters never touch
+    // the same row and the color can be split freely between threads
+    unsigned begin = coloring.colorBegin(c);
+    unsigned end = coloring.colorEnd(c);
+    unsigned use = std::min(threads, std::max((end - begin) / 1024, 1u));
+    if (use == 1) {
+      assembleRange(begin, end);
+      continue;
+    }
+    std::vector<std::thread> pool;
+    unsigned chunk = (end - begin + use - 1) / use;
+    for (unsigned t = 0; t < use; t++) {
+      unsigned b = begin + t * chunk;
+      unsigned e = std::min(end, b + chunk);
+      pool.push_back(std::thread(&Assembly::assembleRange, this, b, e));
+    }
+    for (unsigned t = 0; t < pool.size(); t++) {
+      pool[t].join();
+    }
+  }
+}
+
+double Assembly::benchmark(unsigned threads) {
+  // Repeat until a measurable amount of time has passed
+  unsigned n = conn.size() / 3;
+  unsigned long long assembled = 0;
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  std::chrono::duration<double> elapsed(0);
+  while (elapsed.count() < 0.2) {
+    assemble(threads);
+    assembled += n;
+    elapsed = std::chrono::steady_clock::now() - start;
+  }
+  return assembled / elapsed.count();
+}
+
+unsigned Assembly::rows() const { return rowStart.size() - 1; }
+
+unsigned Assembly::nonzeros() const { return columns.size(); }
+
+unsigned Assembly::numColors() const { return coloring.numColors(); }
+
+const std::vector<unsigned> &Assembly::getRowStart() const { return rowStart; }
+
+const std::vector<unsigned> &Assembly::getColumns() const { return columns; }
+
+const std::vector<double> &Assembly::getValues() const { return values; }
+
+const std::vector<double> &Assembly::getRhs() const { return rhs; }
+
+void Assembly::printMatrix(const char *outFile) const {
+  std::ofstream w(outFile);
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", outFile);
+    exit(EXIT_FAILURE);
+  }
+  // Entries in CSR order as row,column,value (1-based like the .msh)
+  w << "$csr\n" << rows() << "," << nonzeros() << "\n";
+  w << "$matrix\n";
+  for (unsigned r = 0; r < rows(); r++) {
+    for (unsigned k = rowStart[r]; k < rowStart[r + 1]; k++) {
+      w << r + 1 << "," << columns[k] + 1 << "," << values[k] << "\n";
+    }
+  }
+  w << "$rhs\n";
+  for (unsigned r = 0; r < rows(); r++) {
+    w << r + 1 << "," << rhs[r] << "\n";
+  }
+  w.close();
+}
+
+// Protected methods
+void Assembly::buildPattern() {
+  unsigned numNodes = x.size();
+  unsigned d = dofsPerNode;
+  // Node graph with the diagonal merged into each sorted row
+  Graph G = Graph::nodeGraph(conn, numNodes);
+  const std::vector<unsigned> &offsets = G.getOffsets();
+  const std::vector<unsigned> &adjacency = G.getAdjacency();
+  std::vector<unsigned> nodeStart(numNodes + 1, 0);
+  std::vector<unsigned> nodeAdj;
+  nodeAdj.reserve(adjacency.size() + numNodes);
+  for (unsigned i = 0; i < numNodes; i++) {
+    bool placed = false;
+    for (unsigned k = offsets[i]; k < offsets[i + 1]; k++) {
+      if (!placed && adjacency[k] > i) {
+        nodeAdj.push_back(i);
+        placed = true;
+      }
+      nodeAdj.push_back(adjacency[k]);
+    }
+    if (!placed) {
+      nodeAdj.push_back(i);
+    }
+    nodeStart[i + 1] = nodeAdj.size();
+  }
+  // Expand every node entry into a d x d block of dofs
+  rowStart.assign(d * numNodes + 1, 0);
+  columns.clear();
+  columns.reserve(d * d * nodeAdj.size());
+  for (unsigned i = 0; i < numNodes; i++) {
+    for (unsigned r = 0; r < d; r++) {
+      for (unsigned k = nodeStart[i]; k < nodeStart[i + 1]; k++) {
+        for (unsigned s = 0; s < d; s++) {
+          columns.push_back(d * nodeAdj[k] + s);
+        }
+      }
+      rowStart[d * i + r + 1] = columns.size();
+    }
+  }
+  values.assign(columns.size(), 0);
+  rhs.assign(d * numNodes, 0);
+  // Value index of each local entry, so assembly needs no searching. Kept
+  // in color order, like the connectivity the assembly loop reads.
+  const std::vector<unsigned> &colorConn = coloring.getConnectivity();
+  unsigned n = conn.size() / 3;
+  unsigned local = 3 * d;
+  slots.resize(n * local * local);
+  for (unsigned e = 0; e < n; e++) {
+    for (unsigned i = 0; i < 3; i++) {
+      unsigned a = colorConn[3 * e + i];
+      for (unsigned j = 0; j < 3; j++) {
+        unsigned b = colorConn[3 * e + j];
+        unsigned offset =
+            std::lower_bound(nodeAdj.begin() + nodeStart[a],
+                             nodeAdj.begin() + nodeStart[a + 1], b) -
+            (nodeAdj.begin() + nodeStart[a]);
+        for (unsigned r = 0; r < d; r++) {
+          for (unsigned s = 0; s < d; s++) {
+            slots[e * local * local + (d * i + r) * local + d * j + s] =
+                rowStart[d * a + r] + d * offset + s;
+          }
+        }
+      }
+    }
+  }
+}
+
+void Assembly::assembleRange(unsigned begin, unsigned end) {
+  Trace::Span span("assemble range", "worker");
+  const unsigned d = dofsPerNode;
+  const unsigned local = 3 * d;
+  // Plane stress with E = 1, nu = 0.3
+  const double nu = 0.3;
+  const double D0 = 1 / (1 - nu * nu);
+  double Ke[36];
+  const std::vector<unsigned> &colorConn = coloring.getConnectivity();
+  for (unsigned m = begin; m < end; m++) {
+    unsigned n1 = colorConn[3 * m], n2 = colorConn[3 * m + 1];
+    unsigned n3 = colorConn[3 * m + 2];
+    double b[3] = {y[n2] - y[n3], y[n3] - y[n1], y[n1] - y[n2]};
+    double c[3] = {x[n3] - x[n2], x[n1] - x[n3], x[n2] - x[n1]};
+    double area = 0.5 * std::fabs(b[0] * c[1] - b[1] * c[0]);
+    if (problem == POISSON) {
+      // K_ij = (b_i b_j + c_i c_j) / 4A, unit source
+      for (unsigned i = 0; i < 3; i++) {
+        for (unsigned j = 0; j < 3; j++) {
+          Ke[3 * i + j] = (b[i] * b[j] + c[i] * c[j]) / (4 * area);
+        }
+        rhs[colorConn[3 * m + i]] += area / 3;
+      }
+    } else {
+      // K = A B^T D B with B the constant strain-displacement matrix,
+      // unit body force in -y
+      for (unsigned i = 0; i < 3; i++) {
+        for (unsigned j = 0; j < 3; j++) {
+          double s = D0 / (4 * area);
+          double shear = (1 - nu) / 2;
+          Ke[(2 * i) * local + 2 * j] = s * (b[i] * b[j] + shear * c[i] * c[j]);
+          Ke[(2 * i) * local + 2 * j + 1] =
+              s * (nu * b[i] * c[j] + shear * c[i] * b[j]);
+          Ke[(2 * i + 1) * local + 2 * j] =
+              s * (nu * c[i] * b[j] + shear * b[i] * c[j]);
+          Ke[(2 * i + 1) * local + 2 * j + 1] =
+              s * (c[i] * c[j] + shear * b[i] * b[j]);
+        }
+        rhs[2 * colorConn[3 * m + i] + 1] -= area / 3;
+      }
+    }
+    const unsigned *slot = &slots[m * local * local];
+    for (unsigned k = 0; k < local * local; k++) {
+      values[slot[k]] += Ke[k];
+    }
+  }
+}
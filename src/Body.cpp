@@ -2,6 +2,7 @@
 
 // Constructors
 Body::Body(char *readFile) {
+  Trace::Span span("parse");
   x_size = 0;
   y_size = 0;
   try {
@@ -14,6 +15,21 @@ Body::Body(char *readFile) {
   }
 }
 
+Body::Body(double xSize, double ySize, double xMin, double yMin, double xMax,
+           double yMax) {
+  // Same checks and layout as a six line input file, without the file
+  x_size = 0;
+  y_size = 0;
+  if (!(xSize > 0) || !(ySize > 0)) {
+    throw std::runtime_error("Element x-size and y-size must be positive\n");
+  }
+  std::vector<std::vector<double>> fileData = {
+      {xSize},          {ySize},          {1, xMin, yMin},
+      {2, xMax, yMin}, {3, xMin, yMax}, {4, xMax, yMax}};
+  isValid(fileData);
+  buildMe(fileData);
+}
+
 Body::Body(const Body &rhs) {
   x_size = rhs.getXsize();
   y_size = rhs.getYsize();
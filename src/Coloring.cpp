@@ -0,0 +1,226 @@
+#include "../include/Coloring.h"
+
+// Weight of an element in Jones-Plassmann: a fixed integer hash of its
+// index, so the coloring does not depend on the number of threads
+static unsigned long long weight(unsigned e) {
+  unsigned long long z = e + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static bool heavier(unsigned a, unsigned b) {
+  unsigned long long wa = weight(a), wb = weight(b);
+  return wa > wb || (wa == wb && a > b);
+}
+
+// Constructors
+Coloring::Coloring(const std::vector<unsigned> &conn, unsigned nodeCount,
+                   Method method, unsigned threads) {
+  numNodes = nodeCount;
+  numThreads = std::max(threads, 1u);
+  buildIncidence(conn);
+  colors.assign(conn.size() / 3, -1);
+  if (method == JONES_PLASSMANN) {
+    jonesPlassmann(conn);
+  } else {
+    greedy(conn);
+  }
+  layout(conn);
+}
+
+// Public methods
+unsigned Coloring::numColors() const { return colorStart.size() - 1; }
+
+const std::vector<int> &Coloring::getColors() const { return colors; }
+
+unsigned Coloring::colorBegin(unsigned c) const {
+  if (c >= numColors()) {
+    throw std::invalid_argument("Color out of range\n");
+  }
+  return colorStart[c];
+}
+
+unsigned Coloring::colorEnd(unsigned c) const {
+  if (c >= numColors()) {
+    throw std::invalid_argument("Color out of range\n");
+  }
+  return colorStart[c + 1];
+}
+
+const std::vector<unsigned> &Coloring::getElements() const {
+  return colorElems;
+}
+
+const std::vector<unsigned> &Coloring::getConnectivity() const {
+  return colorConn;
+}
+
+bool Coloring::isValid(const std::vector<unsigned> &conn) const {
+  for (unsigned e = 0; e < colors.size(); e++) {
+    if (colors[e] < 0) {
+      return false;
+    }
+    for (int k = 0; k < 3; k++) {
+      unsigned node = conn[3 * e + k];
+      for (unsigned m = nodeStart[node]; m < nodeStart[node + 1]; m++) {
+        if (incident[m] != e && colors[incident[m]] == colors[e]) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Protected methods
+void Coloring::buildIncidence(const std::vector<unsigned> &conn) {
+  nodeStart.assign(numNodes + 1, 0);
+  incident.resize(conn.size());
+  for (unsigned i = 0; i < conn.size(); i++) {
+    nodeStart[conn[i] + 1]++;
+  }
+  for (unsigned i = 0; i < numNodes; i++) {
+    nodeStart[i + 1] += nodeStart[i];
+  }
+  std::vector<unsigned> fill(nodeStart.begin(), nodeStart.end() - 1);
+  for (unsigned i = 0; i < conn.size(); i++) {
+    incident[fill[conn[i]]++] = i / 3;
+  }
+}
+
+void Coloring::greedy(const std::vector<unsigned> &conn) {
+  std::vector<unsigned> scratch;
+  for (unsigned e = 0; e < colors.size(); e++) {
+    colors[e] = firstFreeColor(conn, e, scratch);
+  }
+}
+
+void Coloring::jonesPlassmann(const std::vector<unsigned> &conn) {
+  // Each round colors every uncolored element that outweighs all of its
+  // uncolored conflicts. Such elements never conflict with each other, so
+  // both the selection and the coloring split freely between threads.
+  std::vector<unsigned> pending(colors.size());
+  for (unsigned e = 0; e < pending.size(); e++) {
+    pending[e] = e;
+  }
+  while (!pending.empty()) {
+    unsigned count = pending.size();
+    std::vector<char> selected(count, 0);
+    unsigned threads = std::min(numThreads, std::max(count / 4096, 1u));
+    unsigned chunk = (count + threads - 1) / threads;
+    if (threads == 1) {
+      selectRange(conn, pending, 0, count, selected);
+      colorRange(conn, pending, selected, 0, count);
+    } else {
+      for (int phase = 0; phase < 2; phase++) {
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; t++) {
+          unsigned begin = t * chunk;
+          unsigned end = std::min(count, begin + chunk);
+          if (phase == 0) {
+            pool.push_back(std::thread(&Coloring::selectRange, this,
+                                       std::cref(conn), std::cref(pending),
+                                       begin, end, std::ref(selected)));
+          } else {
+            pool.push_back(std::thread(&Coloring::colorRange, this,
+                                       std::cref(conn), std::cref(pending),
+                                       std::cref(selected), begin, end));
+          }
+        }
+        for (unsigned t = 0; t < pool.size(); t++) {
+          pool[t].join();
+        }
+      }
+    }
+    std::vector<unsigned> next;
+    for (unsigned i = 0; i < count; i++) {
+      if (!selected[i]) {
+        next.push_back(pending[i]);
+      }
+    }
+    pending.swap(next);
+  }
+}
+
+void Coloring::selectRange(const std::vector<unsigned> &conn,
+                           const std::vector<unsigned> &pending,
+                           unsigned begin, unsigned end,
+                           std::vector<char> &selected) const {
+  for (unsigned i = begin; i < end; i++) {
+    unsigned e = pending[i];
+    bool isMax = true;
+    for (int k = 0; k < 3 && isMax; k++) {
+      unsigned node = conn[3 * e + k];
+      for (unsigned m = nodeStart[node]; m < nodeStart[node + 1]; m++) {
+        unsigned f = incident[m];
+        if (f != e && colors[f] == -1 && heavier(f, e)) {
+          isMax = false;
+          break;
+        }
+      }
+    }
+    selected[i] = isMax;
+  }
+}
+
+void Coloring::colorRange(const std::vector<unsigned> &conn,
+                          const std::vector<unsigned> &pending,
+                          const std::vector<char> &selected, unsigned begin,
+                          unsigned end) {
+  Trace::Span span("color range", "worker");
+  std::vector<unsigned> scratch;
+  for (unsigned i = begin; i < end; i++) {
+    if (selected[i]) {
+      colors[pending[i]] = firstFreeColor(conn, pending[i], scratch);
+    }
+  }
+}
+
+int Coloring::firstFreeColor(const std::vector<unsigned> &conn, unsigned e,
+                             std::vector<unsigned> &scratch) const {
+  // Lowest color not taken by an element sharing a node with e
+  scratch.clear();
+  for (int k = 0; k < 3; k++) {
+    unsigned node = conn[3 * e + k];
+    for (unsigned m = nodeStart[node]; m < nodeStart[node + 1]; m++) {
+      int c = colors[incident[m]];
+      if (incident[m] != e && c != -1) {
+        scratch.push_back(c);
+      }
+    }
+  }
+  sort(scratch.begin(), scratch.end());
+  int c = 0;
+  for (unsigned i = 0; i < scratch.size() && (int)scratch[i] <= c; i++) {
+    if ((int)scratch[i] == c) {
+      c++;
+    }
+  }
+  return c;
+}
+
+void Coloring::layout(const std::vector<unsigned> &conn) {
+  // Counting sort of the elements by color, stable in element order
+  int count = 0;
+  for (unsigned e = 0; e < colors.size(); e++) {
+    count = std::max(count, colors[e] + 1);
+  }
+  colorStart.assign(count + 1, 0);
+  for (unsigned e = 0; e < colors.size(); e++) {
+    colorStart[colors[e] + 1]++;
+  }
+  for (int c = 0; c < count; c++) {
+    colorStart[c + 1] += colorStart[c];
+  }
+  colorElems.resize(colors.size());
+  colorConn.resize(conn.size());
+  std::vector<unsigned> next(colorStart.begin(), colorStart.end() - 1);
+  for (unsigned e = 0; e < colors.size(); e++) {
+    unsigned slot = next[colors[e]]++;
+    colorElems[slot] = e;
+    for (int k = 0; k < 3; k++) {
+      colorConn[3 * slot + k] = conn[3 * e + k];
+    }
+  }
+}
@@ -0,0 +1,361 @@
+#include "../include/CompactMesh.h"
+
+// Constructors
+CompactMesh::CompactMesh(double xMin, double yMin, double xMax, double yMax,
+                         std::size_t expectedNodes)
+    : inverted(0), last(0), flips(0), skipped(0) {
+  // Corners in Body order, split along the lower-left to upper-right
+  // diagonal into two counterclockwise elements
+  if (!(xMin < xMax && yMin < yMax) || (float)xMin == (float)xMax ||
+      (float)yMin == (float)yMax) {
+    throw std::invalid_argument("Compact mesh box has no area\n");
+  }
+  if (expectedNodes > INT32_MAX / 2) {
+    throw std::invalid_argument("Mesh too large for 32-bit indices\n");
+  }
+  // Every node past the corners adds two elements
+  x.reserve(std::max<std::size_t>(expectedNodes, 4));
+  y.reserve(std::max<std::size_t>(expectedNodes, 4));
+  conn.reserve(6 * std::max<std::size_t>(expectedNodes, 4));
+  neighbors.reserve(6 * std::max<std::size_t>(expectedNodes, 4));
+  double cornerX[4] = {xMin, xMax, xMin, xMax};
+  double cornerY[4] = {yMin, yMin, yMax, yMax};
+  for (int c = 0; c < 4; c++) {
+    x.push_back(cornerX[c]);
+    y.push_back(cornerY[c]);
+  }
+  addElement(0, 1, 3, -1, 1, -1);
+  addElement(0, 3, 2, -1, -1, 0);
+}
+
+CompactMesh::CompactMesh(const std::vector<double> &xIn,
+                         const std::vector<double> &yIn,
+                         const std::vector<unsigned> &connIn)
+    : last(0), flips(0), skipped(0) {
+  if (xIn.size() > UINT32_MAX || connIn.size() / 3 > INT32_MAX) {
+    throw std::invalid_argument("Mesh too large for 32-bit indices\n");
+  }
+  x.assign(xIn.begin(), xIn.end());
+  y.assign(yIn.begin(), yIn.end());
+  conn.assign(connIn.begin(), connIn.end());
+  EdgeTable table(connIn);
+  const std::vector<int> &adj = table.getNeighbors();
+  neighbors.assign(adj.begin(), adj.end());
+  // Rounding to float can turn a thin element over or flatten it
+  inverted = 0;
+  for (unsigned i = 0; i < numElements(); i++) {
+    unsigned a = conn[3 * i], b = conn[3 * i + 1], c = conn[3 * i + 2];
+    double before =
+        orient2d(xIn[a], yIn[a], xIn[b], yIn[b], xIn[c], yIn[c]);
+    double after = orientation(i);
+    if (after == 0 || (after > 0) != (before > 0)) {
+      inverted++;
+    }
+  }
+}
+
+// Public methods
+bool CompactMesh::insert(double px, double py) {
+  // The walk and every test below run on the rounded point, so the mesh is
+  // exactly Delaunay for the coordinates it stores
+  if (x.size() >= INT32_MAX / 2) {
+    throw std::invalid_argument("Mesh too large for 32-bit indices\n");
+  }
+  px = (float)px;
+  py = (float)py;
+  // Walk from the last element toward the point, leaving across the first
+  // edge the point is strictly outside of; rotating the first edge tried
+  // keeps the walk from circling
+  uint32_t t = last;
+  unsigned steps = 0, limit = 3 * numElements() + 3;
+  int onEdge = -1, zeros = 0;
+  while (true) {
+    if (++steps > limit) {
+      throw std::runtime_error("Compact mesh walk did not end\n");
+    }
+    int next = -1;
+    onEdge = -1;
+    zeros = 0;
+    for (int i = 0; i < 3; i++) {
+      int k = (i + steps) % 3;
+      double s = side(t, k, px, py);
+      if (s < 0) {
+        next = k;
+        break;
+      }
+      if (s == 0) {
+        onEdge = k;
+        zeros++;
+      }
+    }
+    if (next < 0) {
+      break;
+    }
+    int32_t across = neighbors[3 * t + next];
+    if (across < 0) {
+      skipped++;
+      last = t;
+      return false;
+    }
+    t = across;
+  }
+  if (zeros > 1) {
+    // On a node already in the mesh
+    skipped++;
+    last = t;
+    return false;
+  }
+  uint32_t p = x.size();
+  x.push_back(px);
+  y.push_back(py);
+  if (onEdge < 0) {
+    // Inside: three elements around the node, t keeping the first
+    uint32_t a = conn[3 * t], b = conn[3 * t + 1], c = conn[3 * t + 2];
+    int32_t nA = neighbors[3 * t], nB = neighbors[3 * t + 1],
+            nC = neighbors[3 * t + 2];
+    uint32_t t1 = numElements(), t2 = t1 + 1;
+    setElement(t, p, a, b, nC, t1, t2);
+    addElement(p, b, c, nA, t2, t);
+    addElement(p, c, a, nB, t, t1);
+    replaceNeighbor(nA, t, t1);
+    replaceNeighbor(nB, t, t2);
+    pending = {t, t1, t2};
+  } else {
+    // On edge b-c, opposite a: t and the element f across it split in two
+    int k = onEdge;
+    uint32_t a = conn[3 * t + k], b = conn[3 * t + (k + 1) % 3],
+             c = conn[3 * t + (k + 2) % 3];
+    int32_t f = neighbors[3 * t + k], nB = neighbors[3 * t + (k + 1) % 3],
+            nC = neighbors[3 * t + (k + 2) % 3];
+    uint32_t e2 = numElements();
+    int32_t f2 = f < 0 ? -1 : e2 + 1;
+    setElement(t, p, a, b, nC, f2, e2);
+    addElement(p, c, a, nB, t, f);
+    replaceNeighbor(nB, t, e2);
+    pending = {t, e2};
+    if (f >= 0) {
+      // f reads d, c, b from its vertex off the edge
+      int m = 0;
+      while (conn[3 * f + m] == b || conn[3 * f + m] == c) {
+        m++;
+      }
+      uint32_t d = conn[3 * f + m];
+      int32_t fB = neighbors[3 * f + (m + 2) % 3],
+              fC = neighbors[3 * f + (m + 1) % 3];
+      setElement(f, p, d, c, fB, e2, f2);
+      addElement(p, b, d, fC, f, t);
+      replaceNeighbor(fC, f, f2);
+      pending.push_back(f);
+      pending.push_back(f2);
+    }
+  }
+  legalize();
+  last = t;
+  return true;
+}
+
+void CompactMesh::renumber(const std::vector<uint32_t> &newIndex) {
+  if (newIndex.size() != x.size()) {
+    throw std::invalid_argument("Renumbering must cover every node\n");
+  }
+  std::vector<float> newX(x.size()), newY(y.size());
+  std::vector<char> taken(x.size(), 0);
+  for (unsigned i = 0; i < newIndex.size(); i++) {
+    uint32_t to = newIndex[i];
+    if (to >= x.size() || taken[to]) {
+      throw std::invalid_argument("Renumbering is not a permutation\n");
+    }
+    taken[to] = 1;
+    newX[to] = x[i];
+    newY[to] = y[i];
+  }
+  x.swap(newX);
+  y.swap(newY);
+  for (unsigned i = 0; i < conn.size(); i++) {
+    conn[i] = newIndex[conn[i]];
+  }
+}
+
+void CompactMesh::trim() {
+  x.shrink_to_fit();
+  y.shrink_to_fit();
+  conn.shrink_to_fit();
+  neighbors.shrink_to_fit();
+  std::vector<uint32_t>().swap(pending);
+}
+
+unsigned CompactMesh::numNodes() const { return x.size(); }
+
+unsigned CompactMesh::numElements() const { return conn.size() / 3; }
+
+unsigned CompactMesh::numInverted() const { return inverted; }
+
+unsigned CompactMesh::numFlips() const { return flips; }
+
+unsigned CompactMesh::numSkipped() const { return skipped; }
+
+double CompactMesh::orientation(unsigned elem) const {
+  if (elem >= numElements()) {
+    throw std::invalid_argument("Index out of bounds in compact mesh\n");
+  }
+  unsigned a = conn[3 * elem], b = conn[3 * elem + 1], c = conn[3 * elem + 2];
+  return orient2d(x[a], y[a], x[b], y[b], x[c], y[c]);
+}
+
+int CompactMesh::neighbor(unsigned elem, int k) const {
+  if (elem >= numElements() || k < 0 || k > 2) {
+    throw std::invalid_argument("Index out of bounds in compact mesh\n");
+  }
+  return neighbors[3 * elem + k];
+}
+
+const std::vector<uint32_t> &CompactMesh::getConnectivity() const {
+  return conn;
+}
+
+void CompactMesh::getArrays(std::vector<double> &xOut,
+                            std::vector<double> &yOut,
+                            std::vector<unsigned> &connOut) const {
+  xOut.assign(x.begin(), x.end());
+  yOut.assign(y.begin(), y.end());
+  connOut.assign(conn.begin(), conn.end());
+}
+
+std::size_t CompactMesh::bytes() const {
+  return sizeof(CompactMesh) + (x.capacity() + y.capacity()) * sizeof(float) +
+         conn.capacity() * sizeof(uint32_t) +
+         neighbors.capacity() * sizeof(int32_t) +
+         pending.capacity() * sizeof(uint32_t);
+}
+
+double CompactMesh::bytesPerTriangle() const {
+  if (numElements() == 0) {
+    throw std::invalid_argument("No elements to measure\n");
+  }
+  return (double)bytes() / numElements();
+}
+
+void CompactMesh::printMesh(const char *outFile) const {
+  // Same text format as Triangulation::printMesh, IDs from 1
+  std::ofstream w(outFile);
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", outFile);
+    exit(EXIT_FAILURE);
+  }
+  w << "$nodes\n";
+  for (unsigned i = 0; i < numNodes(); i++) {
+    w << i + 1 << "," << x[i] << "," << y[i] << "\n";
+  }
+  w << "$elements\n";
+  for (unsigned j = 0; j < numElements(); j++) {
+    w << j + 1 << "," << conn[3 * j] + 1 << "," << conn[3 * j + 1] + 1 << ","
+      << conn[3 * j + 2] + 1 << "\n";
+  }
+  w.close();
+}
+
+void CompactMesh::printBinary(const char *outFile) const {
+  // Same layout as Triangulation::printBinary, with flags 2 (coordinates
+  // are floats) and 4 (int32 neighbors follow the connectivity)
+  std::ofstream w(outFile, std::ios::binary);
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", outFile);
+    exit(EXIT_FAILURE);
+  }
+  uint32_t header[4] = {1, (uint32_t)x.size(), (uint32_t)numElements(), 6u};
+  w.write("DMSH", 4);
+  w.write((const char *)header, sizeof(header));
+  w.write((const char *)x.data(), x.size() * sizeof(float));
+  w.write((const char *)y.data(), y.size() * sizeof(float));
+  w.write((const char *)conn.data(), conn.size() * sizeof(uint32_t));
+  w.write((const char *)neighbors.data(),
+          neighbors.size() * sizeof(int32_t));
+  w.close();
+}
+
+// Protected methods
+double CompactMesh::side(uint32_t elem, int k, double px, double py) const {
+  // Positive when the point is on the element's side of the edge across
+  // from vertex k
+  uint32_t a = conn[3 * elem + (k + 1) % 3], b = conn[3 * elem + (k + 2) % 3];
+  return orient2d(x[a], y[a], x[b], y[b], px, py);
+}
+
+bool CompactMesh::isLegal(uint32_t s0, uint32_t s1, uint32_t op1,
+                          uint32_t op2) const {
+  // Shared edge s0-s1 of the quad op1, s0, op2, s1 stays unless op2 is
+  // inside the circle through s0, s1, op1: the test Triangulation uses,
+  // ties broken by coordinates and then index
+  const Point2d pts[4] = {Point2d(x[s0], y[s0]), Point2d(x[s1], y[s1]),
+                          Point2d(x[op1], y[op1]), Point2d(x[op2], y[op2])};
+  const unsigned ids[4] = {s0, s1, op1, op2};
+  return isLocallyDelaunay(pts, ids);
+}
+
+void CompactMesh::setElement(uint32_t elem, uint32_t a, uint32_t b,
+                             uint32_t c, int32_t nA, int32_t nB, int32_t nC) {
+  conn[3 * elem] = a;
+  conn[3 * elem + 1] = b;
+  conn[3 * elem + 2] = c;
+  neighbors[3 * elem] = nA;
+  neighbors[3 * elem + 1] = nB;
+  neighbors[3 * elem + 2] = nC;
+}
+
+uint32_t CompactMesh::addElement(uint32_t a, uint32_t b, uint32_t c,
+                                 int32_t nA, int32_t nB, int32_t nC) {
+  uint32_t elem = numElements();
+  conn.insert(conn.end(), {a, b, c});
+  neighbors.insert(neighbors.end(), {nA, nB, nC});
+  return elem;
+}
+
+void CompactMesh::replaceNeighbor(int32_t elem, int32_t from, int32_t to) {
+  if (elem < 0) {
+    return;
+  }
+  for (int k = 0; k < 3; k++) {
+    if (neighbors[3 * elem + k] == from) {
+      neighbors[3 * elem + k] = to;
+      return;
+    }
+  }
+}
+
+void CompactMesh::legalize() {
+  // Lawson flips around the new node p: every pending element reads
+  // (p, u, w), and only its edge u-w, across from p, can be illegal
+  while (!pending.empty()) {
+    uint32_t t = pending.back();
+    pending.pop_back();
+    int32_t n = neighbors[3 * t];
+    if (n < 0) {
+      continue;
+    }
+    uint32_t p = conn[3 * t], u = conn[3 * t + 1], w = conn[3 * t + 2];
+    int m = 0;
+    while (conn[3 * n + m] == u || conn[3 * n + m] == w) {
+      m++;
+    }
+    uint32_t q = conn[3 * n + m]; // n reads (q, w, u)
+    if (isLegal(u, w, p, q)) {
+      continue;
+    }
+    // Flip only a strictly convex quad p, u, q, w
+    double ou = orient2d(x[p], y[p], x[q], y[q], x[u], y[u]);
+    double ow = orient2d(x[p], y[p], x[q], y[q], x[w], y[w]);
+    if (!((ou < 0 && ow > 0) || (ou > 0 && ow < 0))) {
+      continue;
+    }
+    int32_t tU = neighbors[3 * t + 1], tW = neighbors[3 * t + 2];
+    int32_t nW = neighbors[3 * n + (m + 1) % 3],
+            nU = neighbors[3 * n + (m + 2) % 3];
+    setElement(t, p, u, q, nW, n, tW);
+    setElement(n, p, q, w, nU, tU, t);
+    replaceNeighbor(nW, n, t);
+    replaceNeighbor(tU, t, n);
+    flips++;
+    pending.push_back(t);
+    pending.push_back(n);
+  }
+}
@@ -0,0 +1,114 @@
+#include "../include/Differential.h"
+
+// Constructors
+Differential::Differential(Engine ref, unsigned threads)
+    : reference(ref), numThreads(std::max(threads, 1u)), failures(0) {}
+
+// Public methods
+void Differential::addEngine(const std::string &name, Engine engine) {
+  names.push_back(name);
+  engines.push_back(engine);
+}
+
+std::string Differential::run(const std::vector<unsigned> &sizes) {
+  std::ostringstream s;
+  failures = 0;
+  for (unsigned i = 0; i < sizes.size(); i++) {
+    for (int jitter = 0; jitter < 2; jitter++) {
+      std::vector<double> px, py, refX, refY;
+      std::vector<unsigned> refConn;
+      generate(sizes[i], jitter != 0, px, py);
+      double refTime = timed(reference, px, py, refX, refY, refConn);
+      Validator refCheck(refX, refY, refConn, numThreads);
+      Quality refQuality(refX, refY, refConn, numThreads);
+      uint64_t refHash = Triangulation::canonicalHash(refX, refY, refConn);
+      s << sizes[i] << "x" << sizes[i] << (jitter ? " jittered" : " grid")
+        << ": reference " << refConn.size() / 3 << " elements, "
+        << (refCheck.isValid() && refCheck.isDelaunay() ? "valid"
+                                                         : "INVALID")
+        << ", " << refTime << " s\n";
+      for (unsigned e = 0; e < engines.size(); e++) {
+        std::vector<double> x, y;
+        std::vector<unsigned> conn;
+        double time;
+        try {
+          time = timed(engines[e], px, py, x, y, conn);
+          if (x.size() != y.size()) {
+            throw std::runtime_error("Point x and y arrays differ in "
+                                     "length\n");
+          }
+        } catch (const std::exception &ex) {
+          s << "  " << names[e] << ": FAILED, " << ex.what();
+          failures++;
+          continue;
+        }
+        Validator check(x, y, conn, numThreads);
+        if (check.numMalformed() > 0) {
+          // Quality and the hash would read past the point arrays
+          s << "  " << names[e] << ": DISAGREES, " << check.numMalformed()
+            << " elements repeat a node or index past the points\n";
+          failures++;
+          continue;
+        }
+        Quality quality(x, y, conn, numThreads);
+        // Every Delaunay triangulation of the points maximizes the smallest
+        // angle, even where cocircular ties allow more than one
+        bool sameQuality = quality.size() == refQuality.size() &&
+                           std::fabs(quality.min(Quality::MIN_ANGLE) -
+                                     refQuality.min(Quality::MIN_ANGLE)) <
+                               1e-9;
+        bool agrees = check.isValid() && check.isDelaunay() && sameQuality;
+        if (!agrees) {
+          failures++;
+        }
+        s << "  " << names[e] << ": " << (agrees ? "agrees" : "DISAGREES")
+          << ", " << (check.isValid() ? "valid" : "INVALID") << ", "
+          << (check.isDelaunay() ? "Delaunay" : "NOT Delaunay") << ", "
+          << (sameQuality ? "same quality" : "DIFFERENT quality") << ", "
+          << (Triangulation::canonicalHash(x, y, conn) == refHash
+                  ? "identical mesh"
+                  : "different mesh")
+          << ", " << time << " s, speedup " << refTime / time << "x\n";
+      }
+    }
+  }
+  s << failures << " disagreements";
+  return s.str();
+}
+
+unsigned Differential::numFailures() const { return failures; }
+
+// Protected methods
+void Differential::generate(unsigned n, bool jitter, std::vector<double> &x,
+                            std::vector<double> &y) {
+  // n x n cells of the unit square, interior nodes moved by up to a fifth
+  // of a cell when jittered (reproducible, the generator is seeded here).
+  // Coordinates are rounded to float, so the compact engine, which stores
+  // floats, meshes the same points as the others.
+  srand(n);
+  x.clear();
+  y.clear();
+  for (unsigned j = 0; j <= n; j++) {
+    for (unsigned k = 0; k <= n; k++) {
+      double dx = 0, dy = 0;
+      if (jitter && j > 0 && j < n && k > 0 && k < n) {
+        dx = ((double)(rand() % 41) / 100 - 0.2) / n;
+        dy = ((double)(rand() % 41) / 100 - 0.2) / n;
+      }
+      x.push_back((float)((double)j / n + dx));
+      y.push_back((float)((double)k / n + dy));
+    }
+  }
+}
+
+double Differential::timed(const Engine &engine, const std::vector<double> &px,
+                           const std::vector<double> &py,
+                           std::vector<double> &x, std::vector<double> &y,
+                           std::vector<unsigned> &conn) {
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  engine(px, py, x, y, conn);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
@@ -11,9 +11,7 @@ Edge::Edge(const Edge &rhs) {
   source = rhs.getSource();
   sink = rhs.getSink();
   length = rhs.getLength();
-  for (unsigned i = 0; i < rhs.normalize().size(); i++) {
-    edgeVec.push_back(rhs[i]);
-  }
+  edgeVec = rhs.edgeVec;
 }
 
 // Destructor
@@ -23,7 +21,7 @@ Edge::~Edge() {}
 Edge &Edge::operator=(const Edge &rhs) {
   if (&rhs != this) {
     Edge temp = rhs;
-    std::vector<double> v = edgeVec;
+    Vec2d v = edgeVec;
     double l = length;
     Node *so = source;
     Node *si = sink;
@@ -39,20 +37,12 @@ Edge &Edge::operator=(const Edge &rhs) {
   return *this;
 }
 
-double Edge::operator%(std::vector<double> &projectEdge) {
-  double ans = 0;
-  for (unsigned i = 0; i < edgeVec.size(); i++) {
-    ans += edgeVec[i] * projectEdge[i];
-  }
-  return ans / length;
+double Edge::operator%(const Vec2d &projectEdge) {
+  return edgeVec.dot(projectEdge) / length;
 }
 
 double Edge::operator%(Edge &projectEdge) {
-  double ans = 0;
-  for (unsigned i = 0; i < edgeVec.size(); i++) {
-    ans += edgeVec[i] * projectEdge[i];
-  }
-  return ans / length;
+  return edgeVec.dot(projectEdge.edgeVec) / length;
 }
 
 double Edge::operator>(Edge *angleEdge) {
@@ -65,7 +55,7 @@ double Edge::operator>(Edge *angleEdge) {
 }
 
 double Edge::operator[](int index) {
-  if (index >= (int)edgeVec.size() || index < 0) {
+  if (index >= (int)Vec2d::size() || index < 0) {
     throw std::invalid_argument("Index out of bounds in edge\n");
   } else {
     return edgeVec[index];
@@ -73,7 +63,7 @@ double Edge::operator[](int index) {
 }
 
 const double Edge::operator[](int index) const {
-  if (index >= (int)edgeVec.size() || index < 0) {
+  if (index >= (int)Vec2d::size() || index < 0) {
     throw std::invalid_argument("Index out of bounds in edge\n");
   } else {
     return edgeVec[index];
@@ -82,38 +72,22 @@ const double Edge::operator[](int index) const {
 
 // Public methods
 bool Edge::crossesNode(Node *testNode) {
-  if (distanceTo(testNode) < 1e-15) {
-    return true;
-  }
-  return false;
+  return testNode->isOnEdge(source, sink);
 }
 
 void Edge::split(Node *insertNode) {
   // Get both nodes that define this edge, node 1 and node 2
   Node *node1 = source; // get this source
   Node *node2 = sink;   // get this sink
-  // Find edge on node 2 that connects to node 1
-  std::vector<Edge *> edges2 = node2->sourceNode();
-  for (unsigned i = 0; i < edges2.size(); i++) {
-    if (edges2[i]->getSink() == node1) {
-      edges2[i]->setSink(insertNode);
-      edges2[i]->updateVector();
-      break;
-    }
-  }
-  sink = insertNode; // update sink of this edge
+  // Both directions of the edge now end at the inserted node; the nodes
+  // look them up, so this does not depend on how many edges they have
+  node2->redirect(node1, insertNode);
+  node1->redirect(node2, insertNode);
   insertNode->connect(node1);
   insertNode->connect(node2);
-  updateVector();
 }
 
-std::vector<double> Edge::normalize() const {
-  std::vector<double> ans;
-  for (unsigned i = 0; i < edgeVec.size(); i++) {
-    ans.push_back(edgeVec[i] / length);
-  }
-  return ans;
-}
+Vec2d Edge::normalize() const { return edgeVec / length; }
 
 double Edge::distanceTo(Node *node) { return node->distanceTo(this); }
 
@@ -137,13 +111,6 @@ bool Edge::isParallelTo(Edge *testEdge) {
 
 // Protected methods
 void Edge::updateVector() {
-  edgeVec.clear();
-  edgeVec.resize(2);
-  edgeVec[0] = (*sink)[0] - (*source)[0];
-  edgeVec[1] = (*sink)[1] - (*source)[1];
-  double l = 0;
-  for (unsigned i = 0; i < edgeVec.size(); i++) {
-    l += pow(edgeVec[i], 2);
-  }
-  length = sqrt(l);
+  edgeVec = sink->getPoint() - source->getPoint();
+  length = edgeVec.length();
 }
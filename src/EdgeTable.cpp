@@ -0,0 +1,96 @@
+#include "../include/EdgeTable.h"
+
+// Constructors
+EdgeTable::EdgeTable(const std::vector<unsigned> &conn) {
+  unsigned n = conn.size() / 3;
+  overfull = 0;
+  // A triangulation of a disk has about 1.5 edges per element
+  index.reserve(2 * n + 3);
+  edgeNodes.reserve(4 * n);
+  edgeElems.reserve(4 * n);
+  neighbors.assign(3 * n, -1);
+  for (unsigned i = 0; i < n; i++) {
+    for (int k = 0; k < 3; k++) {
+      // Edge k is across from vertex k
+      unsigned a = conn[3 * i + (k + 1) % 3];
+      unsigned b = conn[3 * i + (k + 2) % 3];
+      std::pair<std::unordered_map<unsigned long long, unsigned>::iterator,
+                bool>
+          slot = index.insert(std::make_pair(key(a, b), index.size()));
+      unsigned e = slot.first->second;
+      if (slot.second) {
+        edgeNodes.push_back(std::min(a, b));
+        edgeNodes.push_back(std::max(a, b));
+        edgeElems.push_back(i);
+        edgeElems.push_back(-1);
+      } else if (edgeElems[2 * e + 1] == -1) {
+        int other = edgeElems[2 * e];
+        edgeElems[2 * e + 1] = i;
+        neighbors[3 * i + k] = other;
+        // Fill in the matching slot of the element on the other side
+        for (int m = 0; m < 3; m++) {
+          unsigned c = conn[3 * other + m];
+          if (c != a && c != b) {
+            neighbors[3 * other + m] = i;
+          }
+        }
+      } else {
+        overfull++;
+      }
+    }
+  }
+}
+
+// Public methods
+unsigned long long EdgeTable::key(unsigned a, unsigned b) {
+  if (a > b) {
+    std::swap(a, b);
+  }
+  return ((unsigned long long)a << 32) | b;
+}
+
+unsigned EdgeTable::numEdges() const { return edgeNodes.size() / 2; }
+
+unsigned EdgeTable::numBoundaryEdges() const {
+  unsigned ans = 0;
+  for (unsigned e = 0; e < numEdges(); e++) {
+    if (edgeElems[2 * e + 1] == -1) {
+      ans++;
+    }
+  }
+  return ans;
+}
+
+unsigned EdgeTable::numOverfullEdges() const { return overfull; }
+
+int EdgeTable::find(unsigned a, unsigned b) const {
+  std::unordered_map<unsigned long long, unsigned>::const_iterator it =
+      index.find(key(a, b));
+  if (it == index.end()) {
+    return -1;
+  }
+  return it->second;
+}
+
+unsigned EdgeTable::edgeNode(unsigned e, int which) const {
+  if (e >= numEdges() || which < 0 || which > 1) {
+    throw std::invalid_argument("Index out of bounds in edge table\n");
+  }
+  return edgeNodes[2 * e + which];
+}
+
+int EdgeTable::edgeElement(unsigned e, int which) const {
+  if (e >= numEdges() || which < 0 || which > 1) {
+    throw std::invalid_argument("Index out of bounds in edge table\n");
+  }
+  return edgeElems[2 * e + which];
+}
+
+int EdgeTable::neighbor(unsigned elem, int k) const {
+  if (3 * elem + k >= neighbors.size() || k < 0 || k > 2) {
+    throw std::invalid_argument("Index out of bounds in edge table\n");
+  }
+  return neighbors[3 * elem + k];
+}
+
+const std::vector<int> &EdgeTable::getNeighbors() const { return neighbors; }
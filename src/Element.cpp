@@ -66,59 +66,73 @@ std::ostream &operator<<(std::ostream &s, const Element *rhs) {
 
 // Public methods
 std::vector<Element *> Element::split(Node *internalNode) {
+  // Neighbors are rewired edge by edge, so a split costs the same however
+  // large the mesh or the fans around its vertices
   std::vector<Element *> ans;
   for (unsigned i = 0; i < edges.size(); i++) {
     if (edges[i]->crossesNode(internalNode)) {
-      Edge temp = *(edges[i]);
-      bool extraSplitFlag = false;
-      // Keep track of all elems adjacent to this one, and the one we change
-      std::vector<Element *> oldElems = {this};
-      // Split this element, add it to return vector
-      Element *newElem1 =
-          splitAtEdge(edges[i]->getSource(), edges[i]->getSink(), internalNode);
-      ans.push_back(newElem1);
-      // Find out if this node is on an internal edge
-      for (unsigned j = 0; j < adjacent.size(); j++) {
+      Node *source = edges[i]->getSource();
+      Node *sink = edges[i]->getSink();
+      Node *opposite = findOppositeNode(source, sink);
+      Element *sourceSide = across(source, opposite);
+      Element *sinkSide = across(sink, opposite);
+      // The node may also be on the edge shared with an adjacent element
+      Element *other = nullptr;
+      for (unsigned j = 0; j < adjacent.size() && other == nullptr; j++) {
         if (adjacent[j]->nodeIsOnEdge(internalNode)) {
-          // If it does, we need to add the adjacent to the oldElems
-          oldElems.push_back(adjacent[j]);
-          Element *newElem2 = adjacent[j]->splitAtEdge(
-              temp.getSource(), temp.getSink(), internalNode);
-          ans.push_back(newElem2);
-          extraSplitFlag = true;
-          ans.push_back(adjacent[j]);
+          other = adjacent[j];
         }
       }
-      std::vector<Element *> fringe = getFringe(oldElems);
-      ans.push_back(this);
-      fixAdjacency(ans, fringe);
-      ans.pop_back();
-      if (extraSplitFlag) {
-        ans.pop_back();
+      // This keeps the source half, newElem1 takes the sink half
+      Element *newElem1 = splitAtEdge(source, sink, internalNode);
+      ans.push_back(newElem1);
+      if (other == nullptr) {
+        link(sourceSide, {newElem1});
+        newElem1->link(sinkSide, {this});
+        replaceAcross(sinkSide, this, newElem1);
+        return ans;
       }
+      Node *otherOpposite = other->findOppositeNode(source, sink);
+      Element *otherSourceSide = other->across(source, otherOpposite);
+      Element *otherSinkSide = other->across(sink, otherOpposite);
+      Element *newElem2 = other->splitAtEdge(source, sink, internalNode);
+      ans.push_back(newElem2);
+      link(sourceSide, {newElem1, other});
+      newElem1->link(sinkSide, {newElem2, this});
+      other->link(otherSourceSide, {newElem2, this});
+      newElem2->link(otherSinkSide, {newElem1, other});
+      replaceAcross(sinkSide, this, newElem1);
+      replaceAcross(otherSinkSide, other, newElem2);
       return ans;
     }
   }
+  Element *side02 = across(vertices[0], vertices[2]);
+  Element *side12 = across(vertices[1], vertices[2]);
+  Element *side01 = across(vertices[0], vertices[1]);
   for (unsigned m = 0; m < vertices.size(); m++) {
     internalNode->connect(vertices[m]);
   }
   std::vector<Node *> el1 = {internalNode, vertices[0], vertices[2]};
   std::vector<Node *> el2 = {internalNode, vertices[1], vertices[2]};
-  ans.push_back(new Element(el1));
-  ans.push_back(new Element(el2));
+  Element *newElem1 = new Element(el1);
+  Element *newElem2 = new Element(el2);
+  ans.push_back(newElem1);
+  ans.push_back(newElem2);
   vertices[2] = internalNode;
   getEdges();
-  std::vector<Element *> old = {this};
-  std::vector<Element *> thePool = getFringe(old);
-  ans.push_back(this);
-  fixAdjacency(ans, thePool);
-  ans.pop_back();
+  newElem1->link(side02, {newElem2, this});
+  newElem2->link(side12, {newElem1, this});
+  link(side01, {newElem1, newElem2});
+  replaceAcross(side02, this, newElem1);
+  replaceAcross(side12, this, newElem2);
   return ans;
 }
 
 unsigned Element::getID() const { return elementID; }
 
-std::vector<Node *> Element::getVertices() const { return vertices; }
+void Element::setID(unsigned newID) { elementID = newID; }
+
+const std::vector<Node *> &Element::getVertices() const { return vertices; }
 
 bool Element::isVertex(Node *testNode) {
   for (unsigned i = 0; i < vertices.size(); i++) {
@@ -133,19 +147,14 @@ bool Element::containsNode(Node *testNode) {
   if (isVertex(testNode)) {
     return false;
   }
-  try {
-    std::vector<Edge *> basis = sourceNode(0);
-    Node *origin = basis[0]->getSource();
-    Edge *testEdge = new Edge(origin, testNode);
-    // Solve system using Cramer's rule
-    std::vector<double> coords = findCoordinates(testEdge, basis[0], basis[1]);
-    delete testEdge;
-    return (sqrt(pow(coords[0], 2) + pow(coords[1], 2)) < 1 && coords[0] > 0 &&
-            coords[1] > 0);
-  } catch (std::overflow_error &e) {
-    std::cout << "returned determinant zero" << std::endl;
-    return false;
+  // Strictly inside if the node is on the same side of every edge as the
+  // opposite vertex
+  for (int i = 0; i < 3; i++) {
+    if (sideOf(testNode, i) <= 0) {
+      return false;
+    }
   }
+  return true;
 }
 
 bool Element::nodeIsOnEdge(Node *testNode) {
@@ -157,6 +166,33 @@ bool Element::nodeIsOnEdge(Node *testNode) {
   return false;
 }
 
+int Element::sideOf(Node *testNode, int k) {
+  // Edge k runs from vertex k to vertex k + 1, inside is where the third
+  // vertex is. Elements are not consistently oriented, hence the product.
+  const Point2d &a = vertices[k % 3]->getPoint();
+  const Point2d &b = vertices[(k + 1) % 3]->getPoint();
+  const Point2d &c = vertices[(k + 2) % 3]->getPoint();
+  double side = orient2d(a, b, testNode->getPoint());
+  double inner = orient2d(a, b, c);
+  if (side == 0 || inner == 0) {
+    return 0;
+  }
+  return (side > 0) == (inner > 0) ? 1 : -1;
+}
+
+Element *Element::acrossEdge(int k) {
+  return across(vertices[k % 3], vertices[(k + 1) % 3]);
+}
+
+Element *Element::across(Node *a, Node *b) {
+  for (unsigned i = 0; i < adjacent.size(); i++) {
+    if (adjacent[i]->isVertex(a) && adjacent[i]->isVertex(b)) {
+      return adjacent[i];
+    }
+  }
+  return nullptr;
+}
+
 Node *Element::findOppositeNode(Node *node1, Node *node2) {
   for (unsigned i = 0; i < vertices.size(); i++) {
     if (vertices[i] != node1 && vertices[i] != node2) {
@@ -183,17 +219,16 @@ std::vector<Node *> Element::findSharedNodes(Element *otherElem) {
   return ans;
 }
 
-std::vector<Edge *> Element::sourceNode(int index) {
+std::pair<Edge *, Edge *> Element::sourceNode(int index) const {
+  // A vertex has exactly two element edges, returned without a vector
   if (index >= (int)vertices.size() || index < 0) {
     throw std::invalid_argument("Index out of bounds in element\n");
   }
   Node *thisVertex = vertices[index];
-  std::vector<Edge *> ans;
-  ans.reserve(2);
+  std::pair<Edge *, Edge *> ans(nullptr, nullptr);
   for (unsigned i = 0; i < edges.size(); i++) {
     if (edges[i]->getSource() == thisVertex) {
-      ans.push_back(edges[i]);
-    } else {
+      (ans.first == nullptr ? ans.first : ans.second) = edges[i];
     }
   }
   return ans;
@@ -213,8 +248,7 @@ void Element::redefine(std::vector<Node *> &nodes) {
   getEdges();
 }
 
-std::vector<double> Element::findCoordinates(Edge *testEdge, Edge *basis1,
-                                             Edge *basis2) {
+Vec2d Element::findCoordinates(Edge *testEdge, Edge *basis1, Edge *basis2) {
   // Find coordinates of a vector relative to some basis in 2D using
   // Cramer's rule
   double a1 = (*basis1)[0];
@@ -228,61 +262,59 @@ std::vector<double> Element::findCoordinates(Edge *testEdge, Edge *basis1,
   if (det != 0) {
     double c1 = (v1 * b2 - b1 * v2) / det;
     double c2 = (a1 * v2 - v1 * a2) / det;
-    std::vector<double> C = {c1, c2};
-    return C;
+    return Vec2d(c1, c2);
   } else {
     throw std::runtime_error("Generated line element\n");
   }
 }
 
-std::vector<Element *> Element::getAdjacent() { return adjacent; }
+const std::vector<Element *> &Element::getAdjacent() const {
+  return adjacent;
+}
 
 void Element::setAdjacent(std::vector<Element *> &adj) { adjacent = adj; }
 
-void Element::fixAdjacency(std::vector<Element *> &core,
-                           std::vector<Element *> &fringe) {
-  std::vector<Element *> thePool(fringe);
-  for (unsigned i = 0; i < core.size(); i++) {
-    thePool.push_back(core[i]);
-  }
-  // New elems don't have adjacents, so can build them
-  for (unsigned i = 0; i < core.size(); i++) {
-    std::vector<Element *> adj;
-    for (unsigned j = 0; j < thePool.size(); j++) {
-      if (core[i] != thePool[j] && core[i]->shareEdge(thePool[j])) {
-        adj.push_back(thePool[j]);
-      }
+void Element::replaceAdjacent(Element *oldElem, Element *newElem) {
+  for (unsigned i = 0; i < adjacent.size(); i++) {
+    if (adjacent[i] == oldElem) {
+      adjacent[i] = newElem;
+      return;
     }
-    core[i]->setAdjacent(adj);
   }
-  // Now update the elements in the fringe, check if their adj are valid
-  for (unsigned k = 0; k < fringe.size(); k++) {
-    std::vector<Element *> fringeAdj = fringe[k]->getAdjacent();
-    for (unsigned m = 0; m < fringeAdj.size(); m++) {
-      if (!(fringe[k]->shareEdge(fringeAdj[m]))) {
-        // Search the core for which element does border it.
-        for (unsigned n = 0; n < core.size(); n++) {
-          if (core[n] != fringe[k] && core[n]->shareEdge(fringe[k])) {
-            fringeAdj[m] = core[n];
-            break;
-          }
-        }
-        break;
-      }
-    }
-    fringe[k]->setAdjacent(fringeAdj);
+}
+
+void Element::link(Element *outside, std::initializer_list<Element *> inside) {
+  // The element outside the changed ones comes first, then the changed
+  // ones in the order they were made
+  adjacent.clear();
+  if (outside != nullptr) {
+    adjacent.push_back(outside);
   }
+  adjacent.insert(adjacent.end(), inside);
+}
+
+std::size_t Element::memoryBytes() const {
+  return sizeof(Element) + vertices.capacity() * sizeof(Node *) +
+         edges.capacity() * sizeof(Edge *) +
+         adjacent.capacity() * sizeof(Element *);
 }
 
 // Protected methods
+void Element::replaceAcross(Element *outside, Element *oldElem,
+                            Element *newElem) {
+  if (outside != nullptr) {
+    outside->replaceAdjacent(oldElem, newElem);
+  }
+}
+
 void Element::getEdges() {
+  // Each vertex looks up its edges to the other two
   edges.clear();
   for (unsigned i = 0; i < vertices.size(); i++) {
-    std::vector<Edge *> candidates = vertices[i]->sourceNode();
-    for (unsigned j = 0; j < candidates.size(); j++) {
-      if (candidates[j]->getSink() == vertices[(i + 1) % vertices.size()] ||
-          candidates[j]->getSink() == vertices[(i + 2) % vertices.size()]) {
-        edges.push_back(candidates[j]);
+    for (unsigned j = 1; j < vertices.size(); j++) {
+      Edge *e = vertices[i]->edgeTo(vertices[(i + j) % vertices.size()]);
+      if (e != nullptr) {
+        edges.push_back(e);
       }
     }
   }
@@ -301,24 +333,3 @@ Element *Element::splitAtEdge(Node *source, Node *sink, Node *splitNode) {
   getEdges();
   return new Element(newElem);
 }
-
-std::vector<Element *> Element::getFringe(std::vector<Element *> &core) {
-  std::vector<Element *> fringe = core[0]->getAdjacent();
-  for (unsigned i = 1; i < core.size(); i++) {
-    std::vector<Element *> adj = core[i]->getAdjacent();
-    for (unsigned j = 0; j < adj.size(); j++) {
-      fringe.push_back(adj[j]);
-    }
-  }
-  sort(fringe.begin(), fringe.end());
-  fringe.erase(unique(fringe.begin(), fringe.end()), fringe.end());
-  for (unsigned k = 0; k < core.size(); k++) {
-    for (unsigned m = 0; m < fringe.size(); m++) {
-      if (fringe[m] == core[k]) {
-        fringe.erase(fringe.begin() + m);
-        break;
-      }
-    }
-  }
-  return fringe;
-}
@@ -0,0 +1,102 @@
+#include "../include/FanIndex.h"
+
+// Constructors
+FanIndex::FanIndex(unsigned setMinEdges) : minEdges(setMinEdges) {}
+
+// Operators
+bool FanIndex::Order::operator()(const Node *a, const Node *b) const {
+  // Counterclockwise from the +x direction: the upper half plane (angle 0
+  // included) first, then the orientation decides, exactly. Nodes in the
+  // same direction are equivalent, so a node that splits an edge takes the
+  // place of the node the edge used to reach.
+  const Point2d &c = center->getPoint();
+  const Point2d &p = a->getPoint(), &q = b->getPoint();
+  bool upperP = p[1] > c[1] || (p[1] == c[1] && p[0] > c[0]);
+  bool upperQ = q[1] > c[1] || (q[1] == c[1] && q[0] > c[0]);
+  if (upperP != upperQ) {
+    return upperP;
+  }
+  return orient2d(c, p, q) > 0;
+}
+
+// Public methods
+void FanIndex::update(Element *changed) {
+  for (int k = 0; k < 3; k++) {
+    Node *vertex = (*changed)[k];
+    std::unordered_map<const Node *, Fan>::iterator it = fans.find(vertex);
+    if (it != fans.end()) {
+      add(it->second, vertex, changed);
+    } else if (vertex->sourceNode().size() >= minEdges) {
+      build(vertex, changed);
+    }
+  }
+}
+
+Element *FanIndex::sector(Node *center, Node *target) const {
+  // nullptr if the node is not indexed, the point is the node itself or
+  // the point is outside the mesh as seen from the node
+  std::unordered_map<const Node *, Fan>::const_iterator it = fans.find(center);
+  if (it == fans.end() || it->second.empty()) {
+    return nullptr;
+  }
+  const Point2d &c = center->getPoint(), &t = target->getPoint();
+  if (c[0] == t[0] && c[1] == t[1]) {
+    return nullptr;
+  }
+  // Last neighbor at or clockwise of the point, wrapping around
+  const Fan &fan = it->second;
+  Fan::const_iterator s = fan.upper_bound(target);
+  if (s == fan.begin()) {
+    s = fan.end();
+  }
+  --s;
+  if (s->second == nullptr || !s->second->isVertex(center)) {
+    return nullptr;
+  }
+  return s->second;
+}
+
+// Protected methods
+void FanIndex::add(Fan &fan, Node *center, Element *elem) {
+  // The element lies counterclockwise of the edge to one of its other two
+  // vertices; the other edge bounds the next sector, unknown so far
+  Node *other[2];
+  int n = 0;
+  for (int k = 0; k < 3; k++) {
+    if ((*elem)[k] != center) {
+      other[n++] = (*elem)[k];
+    }
+  }
+  if (orient2d(center->getPoint(), other[0]->getPoint(),
+               other[1]->getPoint()) < 0) {
+    std::swap(other[0], other[1]);
+  }
+  std::pair<Fan::iterator, bool> at =
+      fan.insert(std::make_pair(other[0], elem));
+  at.first->second = elem;
+  // The second edge comes right after the first, unless the fan wraps
+  Fan::iterator after = at.first;
+  fan.insert(++after, std::make_pair(other[1], nullptr));
+}
+
+void FanIndex::build(Node *center, Element *start) {
+  // Once, when the node reaches minEdges: turn around it across the edges
+  // it is on, from an element holding it
+  Fan &fan = fans.insert(std::make_pair(center, Fan(Order{center})))
+                 .first->second;
+  std::vector<Element *> seen = {start};
+  for (unsigned i = 0; i < seen.size(); i++) {
+    add(fan, center, seen[i]);
+    for (int k = 0; k < 3; k++) {
+      Node *other = (*seen[i])[k];
+      if (other == center) {
+        continue;
+      }
+      Element *next = seen[i]->across(center, other);
+      if (next != nullptr &&
+          std::find(seen.begin(), seen.end(), next) == seen.end()) {
+        seen.push_back(next);
+      }
+    }
+  }
+}
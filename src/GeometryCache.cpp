@@ -0,0 +1,149 @@
+#include "../include/GeometryCache.h"
+
+// Constructors
+GeometryCache::GeometryCache(const std::vector<double> &xIn,
+                             const std::vector<double> &yIn,
+                             const std::vector<unsigned> &connIn) {
+  x = xIn;
+  y = yIn;
+  conn = connIn;
+  unsigned n = conn.size() / 3;
+  nodeStart.assign(x.size() + 1, 0);
+  incident.resize(conn.size());
+  for (unsigned i = 0; i < conn.size(); i++) {
+    nodeStart[conn[i] + 1]++;
+  }
+  for (unsigned i = 0; i < x.size(); i++) {
+    nodeStart[i + 1] += nodeStart[i];
+  }
+  std::vector<unsigned> fill(nodeStart.begin(), nodeStart.end() - 1);
+  for (unsigned i = 0; i < conn.size(); i++) {
+    incident[fill[conn[i]]++] = i / 3;
+  }
+  area.resize(n);
+  for (int k = 0; k < 4; k++) {
+    invJ[k].resize(n);
+  }
+  for (int k = 0; k < 3; k++) {
+    gradX[k].resize(n);
+    gradY[k].resize(n);
+  }
+  isDirty.assign(n, 0);
+  computeRange(0, n);
+}
+
+// Public methods
+unsigned GeometryCache::size() const { return area.size(); }
+
+void GeometryCache::moveNode(unsigned node, double newX, double newY) {
+  if (node >= x.size()) {
+    throw std::invalid_argument("Index out of bounds in geometry cache\n");
+  }
+  x[node] = newX;
+  y[node] = newY;
+  for (unsigned m = nodeStart[node]; m < nodeStart[node + 1]; m++) {
+    if (!isDirty[incident[m]]) {
+      isDirty[incident[m]] = 1;
+      dirty.push_back(incident[m]);
+    }
+  }
+}
+
+void GeometryCache::update() {
+  // Recompute runs of consecutive invalid elements in one kernel call each
+  sort(dirty.begin(), dirty.end());
+  unsigned i = 0;
+  while (i < dirty.size()) {
+    unsigned j = i + 1;
+    while (j < dirty.size() && dirty[j] == dirty[j - 1] + 1) {
+      j++;
+    }
+    computeRange(dirty[i], dirty[j - 1] + 1);
+    i = j;
+  }
+  for (i = 0; i < dirty.size(); i++) {
+    isDirty[dirty[i]] = 0;
+  }
+  dirty.clear();
+}
+
+unsigned GeometryCache::numDirty() const { return dirty.size(); }
+
+const std::vector<double> &GeometryCache::getArea() const { return area; }
+
+const std::vector<double> &GeometryCache::getInvJ(int k) const {
+  if (k < 0 || k > 3) {
+    throw std::invalid_argument("Index out of bounds in geometry cache\n");
+  }
+  return invJ[k];
+}
+
+const std::vector<double> &GeometryCache::getGradX(int k) const {
+  if (k < 0 || k > 2) {
+    throw std::invalid_argument("Index out of bounds in geometry cache\n");
+  }
+  return gradX[k];
+}
+
+const std::vector<double> &GeometryCache::getGradY(int k) const {
+  if (k < 0 || k > 2) {
+    throw std::invalid_argument("Index out of bounds in geometry cache\n");
+  }
+  return gradY[k];
+}
+
+void GeometryCache::write(std::ostream &w) const {
+  // Area, the four inverse Jacobian entries, then x and y gradients of
+  // each shape function, one full array at a time
+  std::streamsize bytes = area.size() * sizeof(double);
+  w.write((const char *)area.data(), bytes);
+  for (int k = 0; k < 4; k++) {
+    w.write((const char *)invJ[k].data(), bytes);
+  }
+  for (int k = 0; k < 3; k++) {
+    w.write((const char *)gradX[k].data(), bytes);
+    w.write((const char *)gradY[k].data(), bytes);
+  }
+}
+
+// Protected methods
+void GeometryCache::computeRange(unsigned begin, unsigned end) {
+  // Gather vertex coordinates first so the arithmetic below is one
+  // branch-free loop over contiguous arrays
+  unsigned n = end - begin;
+  std::vector<double> x1(n), y1(n), x2(n), y2(n), x3(n), y3(n);
+  for (unsigned i = 0; i < n; i++) {
+    unsigned e = begin + i;
+    x1[i] = x[conn[3 * e]];
+    y1[i] = y[conn[3 * e]];
+    x2[i] = x[conn[3 * e + 1]];
+    y2[i] = y[conn[3 * e + 1]];
+    x3[i] = x[conn[3 * e + 2]];
+    y3[i] = y[conn[3 * e + 2]];
+  }
+  double *A = area.data() + begin;
+  double *i00 = invJ[0].data() + begin, *i01 = invJ[1].data() + begin;
+  double *i10 = invJ[2].data() + begin, *i11 = invJ[3].data() + begin;
+  double *gx1 = gradX[0].data() + begin, *gy1 = gradY[0].data() + begin;
+  double *gx2 = gradX[1].data() + begin, *gy2 = gradY[1].data() + begin;
+  double *gx3 = gradX[2].data() + begin, *gy3 = gradY[2].data() + begin;
+  for (unsigned i = 0; i < n; i++) {
+    // J = [x2 - x1, x3 - x1; y2 - y1, y3 - y1], det J = twice signed area
+    double j00 = x2[i] - x1[i], j01 = x3[i] - x1[i];
+    double j10 = y2[i] - y1[i], j11 = y3[i] - y1[i];
+    double det = j00 * j11 - j01 * j10;
+    double inv = 1 / det;
+    A[i] = 0.5 * std::fabs(det);
+    i00[i] = j11 * inv;
+    i01[i] = -j01 * inv;
+    i10[i] = -j10 * inv;
+    i11[i] = j00 * inv;
+    // grad N = J^-T grad of the reference shape functions
+    gx2[i] = j11 * inv;
+    gy2[i] = -j01 * inv;
+    gx3[i] = -j10 * inv;
+    gy3[i] = j00 * inv;
+    gx1[i] = -gx2[i] - gx3[i];
+    gy1[i] = -gy2[i] - gy3[i];
+  }
+}
@@ -0,0 +1,89 @@
+#include "../include/Graph.h"
+
+// Constructors
+Graph::Graph(const std::vector<unsigned> &rowStart,
+             const std::vector<unsigned> &neighbors) {
+  if (rowStart.size() == 0 || rowStart.back() != neighbors.size()) {
+    throw std::invalid_argument("CSR offsets do not match adjacency\n");
+  }
+  offsets = rowStart;
+  adjacency = neighbors;
+}
+
+// Public methods
+Graph Graph::nodeGraph(const std::vector<unsigned> &conn, unsigned numNodes) {
+  EdgeTable table(conn);
+  std::vector<unsigned> rowStart(numNodes + 1, 0);
+  for (unsigned e = 0; e < table.numEdges(); e++) {
+    rowStart[table.edgeNode(e, 0) + 1]++;
+    rowStart[table.edgeNode(e, 1) + 1]++;
+  }
+  for (unsigned i = 0; i < numNodes; i++) {
+    rowStart[i + 1] += rowStart[i];
+  }
+  std::vector<unsigned> neighbors(rowStart[numNodes]);
+  std::vector<unsigned> fill(rowStart.begin(), rowStart.end() - 1);
+  for (unsigned e = 0; e < table.numEdges(); e++) {
+    unsigned a = table.edgeNode(e, 0);
+    unsigned b = table.edgeNode(e, 1);
+    neighbors[fill[a]++] = b;
+    neighbors[fill[b]++] = a;
+  }
+  // Rows are short, so sorting them keeps the whole build linear
+  for (unsigned i = 0; i < numNodes; i++) {
+    sort(neighbors.begin() + rowStart[i], neighbors.begin() + rowStart[i + 1]);
+  }
+  return Graph(rowStart, neighbors);
+}
+
+Graph Graph::dualGraph(const std::vector<unsigned> &conn) {
+  EdgeTable table(conn);
+  const std::vector<int> &across = table.getNeighbors();
+  unsigned n = conn.size() / 3;
+  std::vector<unsigned> rowStart(n + 1, 0);
+  std::vector<unsigned> neighbors;
+  neighbors.reserve(3 * n);
+  for (unsigned i = 0; i < n; i++) {
+    unsigned first = neighbors.size();
+    for (int k = 0; k < 3; k++) {
+      if (across[3 * i + k] != -1) {
+        neighbors.push_back(across[3 * i + k]);
+      }
+    }
+    sort(neighbors.begin() + first, neighbors.end());
+    rowStart[i + 1] = neighbors.size();
+  }
+  return Graph(rowStart, neighbors);
+}
+
+unsigned Graph::size() const { return offsets.size() - 1; }
+
+unsigned Graph::numEdges() const { return adjacency.size() / 2; }
+
+unsigned Graph::degree(unsigned i) const {
+  if (i >= size()) {
+    throw std::invalid_argument("Index out of bounds in graph\n");
+  }
+  return offsets[i + 1] - offsets[i];
+}
+
+const std::vector<unsigned> &Graph::getOffsets() const { return offsets; }
+
+const std::vector<unsigned> &Graph::getAdjacency() const { return adjacency; }
+
+void Graph::printMetis(const char *outFile) const {
+  // Header "vertices edges", then the neighbors of each vertex per line
+  std::ofstream w(outFile);
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", outFile);
+    exit(EXIT_FAILURE);
+  }
+  w << size() << " " << numEdges() << "\n";
+  for (unsigned i = 0; i < size(); i++) {
+    for (unsigned k = offsets[i]; k < offsets[i + 1]; k++) {
+      w << (k == offsets[i] ? "" : " ") << adjacency[k] + 1;
+    }
+    w << "\n";
+  }
+  w.close();
+}
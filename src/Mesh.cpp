@@ -8,12 +8,45 @@ Mesh::Mesh(Body &inBody) {
   T = nullptr;
 }
 
-Mesh::Mesh(const Mesh &rhs) {
-  for (unsigned i = 0; i < rhs.size(); i++) {
-    nodes.push_back(new Node(*(rhs[i])));
+Mesh::Mesh(const Mesh &rhs)
+    : body(rhs.body), T(nullptr), x_size(rhs.x_size),
+      y_size(rhs.y_size) {
+  // Fresh nodes with the same IDs; Node's own copy would share its edges
+  std::unordered_map<const Node *, Node *> match;
+  for (unsigned i = 0; i < rhs.nodes.size(); i++) {
+    Node *n = new Node((*rhs.nodes[i])[0], (*rhs.nodes[i])[1]);
+    n->setID(rhs.nodes[i]->getID());
+    nodes.push_back(n);
+    match[rhs.nodes[i]] = n;
+  }
+  // Bounding nodes belong to the mesh once it is built; before that they
+  // are handed to nodes by mesh(), so each copy needs its own
+  for (unsigned i = 0; i < body.size(); i++) {
+    if (match.count(body[i]) == 0) {
+      Node *n = new Node((*body[i])[0], (*body[i])[1]);
+      n->setID(body[i]->getID());
+      match[body[i]] = n;
+    }
+    body[i] = match[body[i]];
+  }
+  if (rhs.T != nullptr) {
+    const std::vector<Node *> &old = rhs.T->getNodes();
+    std::vector<Node *> grid(old.size());
+    for (unsigned i = 0; i < old.size(); i++) {
+      grid[i] = match[old[i]];
+    }
+    T = new Triangulation(*rhs.T, grid);
   }
 }
 
+Mesh::Mesh(Mesh &&rhs)
+    : body(std::move(rhs.body)), nodes(std::move(rhs.nodes)),
+      T(rhs.T), x_size(rhs.x_size), y_size(rhs.y_size) {
+  rhs.body.clear();
+  rhs.nodes.clear();
+  rhs.T = nullptr;
+}
+
 // Destructor
 Mesh::~Mesh() {
   for (unsigned i = 0; i < nodes.size(); i++) {
@@ -26,9 +59,20 @@ Mesh::~Mesh() {
 Mesh &Mesh::operator=(const Mesh &rhs) {
   if (&rhs != this) {
     Mesh temp = rhs;
-    std::vector<Node *> n = nodes;
-    nodes = temp.nodes;
-    temp.nodes = n;
+    *this = std::move(temp);
+  }
+  return *this;
+}
+
+Mesh &Mesh::operator=(Mesh &&rhs) {
+  // The old nodes and triangulation go with rhs, which is about to be
+  // destroyed
+  if (&rhs != this) {
+    std::swap(body, rhs.body);
+    std::swap(nodes, rhs.nodes);
+    std::swap(T, rhs.T);
+    std::swap(x_size, rhs.x_size);
+    std::swap(y_size, rhs.y_size);
   }
   return *this;
 }
@@ -46,11 +90,247 @@ void Mesh::mesh() {
   for (unsigned i = 0; i < body.size(); i++) {
     nodes.push_back(body[i]);
   }
-  createGrid(nodes);
+  {
+    Trace::Span span("createGrid");
+    createGrid(nodes);
+  }
   // Form triangulation per the prescribed algorithm
+  Trace::Span span("triangulate");
   T = new Triangulation(nodes);
 }
 
+// Position of grid node (j, k) of an nx by ny cell grid in the order
+// createGrid lists nodes (j outer, k inner, corners first), plus one
+static unsigned gridNodeID(int j, int k, int nx, int ny) {
+  bool xEnd = (j == 0 || j == nx), yEnd = (k == 0 || k == ny);
+  if (xEnd && yEnd) {
+    return 1 + (j == nx ? 1 : 0) + (k == ny ? 2 : 0);
+  }
+  unsigned linear = j * (ny + 1) + k;
+  // Corners come before (j, k) in the j-major order: (0, 0), (0, ny), and
+  // (nx, 0) once j reaches the last column
+  unsigned skipped = j == 0 ? 1 : (j == nx ? 3 : 2);
+  return 4 + linear - skipped + 1;
+}
+
+std::string Mesh::meshTiled(const char *outFile, unsigned tiles) {
+  if (body.size() == 0) {
+    throw noBody();
+  }
+  if (T != nullptr || nodes.size() != 0) {
+    throw std::invalid_argument("Mesh has already been built\n");
+  }
+  // The same grid createGrid builds over the whole body. Tile edges lie on
+  // grid lines and node coordinates depend only on the grid position, so
+  // both tiles on a seam create identical seam nodes and edges.
+  double x_min = (*body[0])[0], x_max = (*body[1])[0];
+  double y_min = (*body[0])[1], y_max = (*body[2])[1];
+  int nx = ceil((x_max - x_min) / x_size);
+  int ny = ceil((y_max - y_min) / y_size);
+  double dx = (x_max - x_min) / nx, dy = (y_max - y_min) / ny;
+  for (unsigned i = 0; i < body.size(); i++) {
+    delete body[i];
+  }
+  body.clear();
+  int tilesX = std::max(1, std::min((int)tiles, nx));
+  int tilesY = std::max(1, std::min((int)tiles, ny));
+  std::string root = std::string(outFile) + ".tiled.msh";
+  std::ofstream w(root.c_str());
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", root.c_str());
+    exit(EXIT_FAILURE);
+  }
+  // Nodes stream straight from the grid, in gridNodeID order
+  w << "$nodes\n";
+  int corners[4][2] = {{0, 0}, {nx, 0}, {0, ny}, {nx, ny}};
+  for (int c = 0; c < 4; c++) {
+    w << c + 1 << "," << (corners[c][0] == 0 ? x_min : x_max) << ","
+      << (corners[c][1] == 0 ? y_min : y_max) << "\n";
+  }
+  for (int j = 0; j <= nx; j++) {
+    for (int k = 0; k <= ny; k++) {
+      if ((j == 0 || j == nx) && (k == 0 || k == ny)) {
+        continue;
+      }
+      w << gridNodeID(j, k, nx, ny) << ","
+        << (j == nx ? x_max : dx * j + x_min) << ","
+        << (k == ny ? y_max : dy * k + y_min) << "\n";
+    }
+  }
+  // Then one tile at a time: build, Delaunay, write, free
+  w << "$elements\n";
+  unsigned numElements = 0, largestTile = 0;
+  std::size_t largestBytes = 0;
+  for (int tx = 0; tx < tilesX; tx++) {
+    for (int ty = 0; ty < tilesY; ty++) {
+      int j0 = tx * nx / tilesX, j1 = (tx + 1) * nx / tilesX;
+      int k0 = ty * ny / tilesY, k1 = (ty + 1) * ny / tilesY;
+      std::vector<Node *> tileNodes;
+      std::vector<unsigned> ids;
+      int order[4][2] = {{j0, k0}, {j1, k0}, {j0, k1}, {j1, k1}};
+      for (int c = 0; c < 4; c++) {
+        int j = order[c][0], k = order[c][1];
+        tileNodes.push_back(new Node(j == nx ? x_max : dx * j + x_min,
+                                     k == ny ? y_max : dy * k + y_min));
+        ids.push_back(gridNodeID(j, k, nx, ny));
+      }
+      for (int j = j0; j <= j1; j++) {
+        for (int k = k0; k <= k1; k++) {
+          if ((j == j0 || j == j1) && (k == k0 || k == k1)) {
+            continue;
+          }
+          tileNodes.push_back(new Node(j == nx ? x_max : dx * j + x_min,
+                                       k == ny ? y_max : dy * k + y_min));
+          ids.push_back(gridNodeID(j, k, nx, ny));
+        }
+      }
+      Triangulation *tile = nullptr;
+      try {
+        tile = new Triangulation(tileNodes);
+        tile->Delaunay();
+        std::vector<double> x, y;
+        std::vector<unsigned> conn;
+        tile->getArrays(x, y, conn);
+        for (unsigned e = 0; e < conn.size() / 3; e++) {
+          w << ++numElements << "," << ids[conn[3 * e]] << ","
+            << ids[conn[3 * e + 1]] << "," << ids[conn[3 * e + 2]] << "\n";
+        }
+        if (tile->memoryBytes() > largestBytes) {
+          largestBytes = tile->memoryBytes();
+          largestTile = conn.size() / 3;
+        }
+      } catch (...) {
+        delete tile;
+        for (unsigned i = 0; i < tileNodes.size(); i++) {
+          delete tileNodes[i];
+        }
+        throw;
+      }
+      delete tile;
+      for (unsigned i = 0; i < tileNodes.size(); i++) {
+        delete tileNodes[i];
+      }
+    }
+  }
+  w.close();
+  std::ostringstream s;
+  s << root << ": " << tilesX * tilesY << " tiles, " << numElements
+    << " elements, " << (nx + 1) * (ny + 1) << " nodes; largest tile "
+    << largestTile << " elements in " << largestBytes << " bytes";
+  return s.str();
+}
+
+void Mesh::mesh(const std::vector<double> &x, const std::vector<double> &y) {
+  if (body.size() == 0) {
+    throw noBody();
+  }
+  if (x.size() != y.size()) {
+    throw std::invalid_argument("Point x and y arrays differ in length\n");
+  }
+  if (T != nullptr || nodes.size() != 0) {
+    throw std::invalid_argument("Mesh has already been built\n");
+  }
+  double x_min = (*body[0])[0], x_max = (*body[1])[0];
+  double y_min = (*body[0])[1], y_max = (*body[2])[1];
+  // Repeated points, including the corners, would never be inserted
+  std::set<std::pair<double, double>> seen;
+  for (unsigned i = 0; i < body.size(); i++) {
+    nodes.push_back(body[i]);
+    seen.insert(std::make_pair((*body[i])[0], (*body[i])[1]));
+  }
+  for (unsigned i = 0; i < x.size(); i++) {
+    if (!(x[i] >= x_min && x[i] <= x_max && y[i] >= y_min && y[i] <= y_max)) {
+      throw std::invalid_argument("Point lies outside the body\n");
+    }
+    if (seen.insert(std::make_pair(x[i], y[i])).second) {
+      nodes.push_back(new Node(x[i], y[i]));
+    }
+  }
+  Trace::Span span("triangulate");
+  T = new Triangulation(nodes);
+}
+
+// A node or element ID read from a mesh file: a whole number from 1 up to,
+// not including, the largest unsigned (IDs are counted in unsigned)
+static unsigned fileID(double value, const std::string &line) {
+  if (!(value >= 1 && value < UINT_MAX) || value != std::floor(value)) {
+    throw std::runtime_error("Mesh file line `" + line +
+                             "` has an ID that is not a whole number from 1 "
+                             "to " + std::to_string(UINT_MAX - 1) + ".\n");
+  }
+  return (unsigned)value;
+}
+
+void Mesh::load(const char *inFile) {
+  Trace::Span span("load");
+  if (T != nullptr || nodes.size() != 0) {
+    throw std::invalid_argument("Mesh has already been built\n");
+  }
+  std::ifstream f(inFile);
+  if (!f.is_open()) {
+    throw std::runtime_error("There was an error opening file.\n");
+  }
+  // Node IDs in the file need not be contiguous, so map them to positions
+  std::unordered_map<unsigned, unsigned> index;
+  std::vector<unsigned> conn;
+  std::vector<unsigned> elemIDs;
+  std::string line;
+  int section = 0;
+  while (std::getline(f, line)) {
+    if (line.size() == 0) {
+      continue;
+    } else if (line == "$nodes") {
+      section = 1;
+      continue;
+    } else if (line == "$elements") {
+      section = 2;
+      continue;
+    }
+    std::vector<double> values;
+    const char *p = line.c_str();
+    char *end;
+    while (*p != '\0') {
+      values.push_back(strtod(p, &end));
+      if (end == p || (*end != ',' && *end != '\0')) {
+        throw std::runtime_error("Mesh file line `" + line +
+                                 "` is not a comma separated number list.\n");
+      }
+      p = *end == ',' ? end + 1 : end;
+    }
+    if (section == 1 && values.size() == 3) {
+      unsigned id = fileID(values[0], line);
+      Node *newNode = new Node(values[1], values[2]);
+      newNode->setID(id);
+      if (!index.insert(std::make_pair(id, nodes.size())).second) {
+        delete newNode;
+        throw std::runtime_error("Mesh file repeats node ID.\n");
+      }
+      nodes.push_back(newNode);
+    } else if (section == 2 && values.size() == 4) {
+      for (int k = 1; k < 4; k++) {
+        std::unordered_map<unsigned, unsigned>::iterator it =
+            index.find(fileID(values[k], line));
+        if (it == index.end()) {
+          throw std::runtime_error("Mesh file element uses unknown node.\n");
+        }
+        conn.push_back(it->second);
+      }
+      elemIDs.push_back(fileID(values[0], line));
+    } else {
+      throw std::runtime_error("Mesh file must contain $nodes (ID,x,y) then "
+                               "$elements (ID,node,node,node).\n");
+    }
+  }
+  if (conn.size() == 0) {
+    throw std::runtime_error("Mesh file contains no elements.\n");
+  }
+  T = new Triangulation(nodes, conn);
+  const std::vector<Element *> &elements = T->getElem();
+  for (unsigned i = 0; i < elements.size(); i++) {
+    elements[i]->setID(elemIDs[i]);
+  }
+}
+
 void Mesh::printMesh() {
   if (nodes.size() != 0 || T != nullptr) {
     T->printMesh();
@@ -60,6 +340,7 @@ void Mesh::printMesh() {
 }
 
 void Mesh::printMesh(const char *outFile) {
+  Trace::Span span("printMesh");
   if (nodes.size() != 0 || T != nullptr) {
     T->printMesh(outFile);
   } else {
@@ -67,9 +348,25 @@ void Mesh::printMesh(const char *outFile) {
   }
 }
 
+void Mesh::printBinary(const char *outFile, bool geometry) {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  if (!geometry) {
+    T->printBinary(outFile);
+    return;
+  }
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  T->getArrays(x, y, conn);
+  GeometryCache cache(x, y, conn);
+  T->printBinary(outFile, &cache);
+}
+
 unsigned Mesh::size() const { return nodes.size(); }
 
 void Mesh::Delaunay() {
+  Trace::Span span("Delaunay");
   if (nodes.size() != 0 || T != nullptr) {
     T->Delaunay();
   } else {
@@ -77,16 +374,391 @@ void Mesh::Delaunay() {
   }
 }
 
+void Mesh::DelaunayMinAngle() {
+  Trace::Span span("Delaunay");
+  if (nodes.size() != 0 || T != nullptr) {
+    T->DelaunayMinAngle();
+  } else {
+    throw noMesh();
+  }
+}
+
+std::string Mesh::DelaunayPriority(const char *outFile,
+                                   const Triangulation::FlipBudget &budget) {
+  Trace::Span span("Delaunay");
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  unsigned before = T->getFlipStats().flipped;
+  Triangulation::StopReason reason = T->DelaunayPriority(budget);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  const char *why[] = {"converged", "reached the angle target",
+                       "ran out of time", "ran out of flips"};
+  std::ostringstream s;
+  s << T->fileRoot(outFile) << ": priority Delaunay " << why[reason]
+    << " after " << T->getFlipStats().flipped - before << " flips in "
+    << elapsed.count() << " s";
+  return s.str();
+}
+
+void Mesh::moveNode(unsigned index, double x, double y,
+                    GeometryCache *cache) {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  T->moveNode(index, x, y, cache);
+}
+
 void Mesh::randomize() {
   srand(time(NULL));
   for (unsigned i = 0; i < body.size(); i++) {
     nodes.push_back(body[i]);
   }
-  createGrid(nodes, true);
+  {
+    Trace::Span span("createGrid");
+    createGrid(nodes, true);
+  }
+  Trace::Span span("triangulate");
   T = new Triangulation(nodes);
   T->setRandFlag(true);
 }
 
+std::string Mesh::quality(const char *outFile, unsigned threads) {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  Trace::Span span("quality");
+  Quality Q(*T, threads);
+  std::string root = T->fileRoot(outFile);
+  Q.printReport((root + ".qual").c_str());
+  return root + ": " + Q.summary();
+}
+
+Validator Mesh::verify(unsigned threads) const {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  Trace::Span span("verify");
+  return Validator(*T, threads);
+}
+
+std::string Mesh::renumber(const char *outFile, const std::string &method) {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  T->getArrays(x, y, conn);
+  Ordering O(conn, x.size());
+  std::vector<unsigned> before = O.identity();
+  std::vector<unsigned> after;
+  if (method == "rcm") {
+    after = O.reverseCuthillMcKee();
+  } else if (method == "sloan") {
+    after = O.sloan();
+  } else {
+    throw std::invalid_argument("Unknown renumbering method " + method +
+                                "\n");
+  }
+  T->renumberNodes(after);
+  std::ostringstream s;
+  s << T->fileRoot(outFile) << ": " << method << " bandwidth "
+    << O.bandwidth(before) << " -> " << O.bandwidth(after) << ", profile "
+    << O.profile(before) << " -> " << O.profile(after);
+  return s.str();
+}
+
+std::string Mesh::reorder(const char *outFile, const std::string &method) {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  if (method != "hilbert" && method != "morton") {
+    throw std::invalid_argument("Unknown reordering method " + method + "\n");
+  }
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  T->getArrays(x, y, conn);
+  double before = Ordering::sweepTime(x, y, conn);
+  // Elements are sorted by centroid, nodes by position, on the same curve
+  unsigned numElem = conn.size() / 3;
+  std::vector<double> cx(numElem), cy(numElem);
+  for (unsigned i = 0; i < numElem; i++) {
+    cx[i] = (x[conn[3 * i]] + x[conn[3 * i + 1]] + x[conn[3 * i + 2]]) / 3;
+    cy[i] = (y[conn[3 * i]] + y[conn[3 * i + 1]] + y[conn[3 * i + 2]]) / 3;
+  }
+  T->renumberElements(Ordering::curve(cx, cy, method == "hilbert"));
+  T->renumberNodes(Ordering::curve(x, y, method == "hilbert"));
+  T->getArrays(x, y, conn);
+  double after = Ordering::sweepTime(x, y, conn);
+  std::ostringstream s;
+  s << T->fileRoot(outFile) << ": " << method << " order, assembly sweep "
+    << before * 1e6 << " us -> " << after * 1e6 << " us";
+  return s.str();
+}
+
+std::string Mesh::partition(const char *outFile, unsigned numParts,
+                            bool inertial) {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  T->getArrays(x, y, conn);
+  Partition P(x, y, conn, numParts, inertial);
+  const std::vector<Node *> &n = T->getNodes();
+  const std::vector<Element *> &e = T->getElem();
+  std::vector<unsigned> nodeIDs(n.size()), elemIDs(e.size());
+  for (unsigned i = 0; i < n.size(); i++) {
+    nodeIDs[i] = n[i]->getID();
+  }
+  for (unsigned i = 0; i < e.size(); i++) {
+    elemIDs[i] = e[i]->getID();
+  }
+  std::string root = T->fileRoot(outFile);
+  P.write(root, nodeIDs, elemIDs);
+  std::vector<unsigned> sizes = P.partSizes();
+  std::ostringstream s;
+  s << root << ": " << numParts << " parts ("
+    << (inertial ? "inertial" : "coordinate") << " bisection), edge cut "
+    << P.edgeCutBeforeRefinement() << " -> " << P.edgeCut() << ", sizes";
+  for (unsigned i = 0; i < sizes.size(); i++) {
+    s << (i == 0 ? " " : "/") << sizes[i];
+  }
+  return s.str();
+}
+
+std::string Mesh::assemble(const char *outFile, const std::string &problem,
+                           unsigned threads) {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  Assembly::Problem which;
+  if (problem == "poisson") {
+    which = Assembly::POISSON;
+  } else if (problem == "elasticity") {
+    which = Assembly::ELASTICITY;
+  } else {
+    throw std::invalid_argument("Unknown problem " + problem + "\n");
+  }
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  T->getArrays(x, y, conn);
+  Assembly A(x, y, conn, which);
+  double rate = A.benchmark(threads);
+  std::string root = T->fileRoot(outFile);
+  A.printMatrix((root + ".csr").c_str());
+  std::ostringstream s;
+  s << root << ": " << problem << " " << A.rows() << " rows, "
+    << A.nonzeros() << " nonzeros, " << A.numColors() << " colors, "
+    << rate << " elements/s on " << threads << " thread(s)";
+  return s.str();
+}
+
+std::string Mesh::color(const char *outFile, const std::string &method,
+                        unsigned threads) {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  Coloring::Method which;
+  if (method == "greedy") {
+    which = Coloring::GREEDY;
+  } else if (method == "jp") {
+    which = Coloring::JONES_PLASSMANN;
+  } else {
+    throw std::invalid_argument("Unknown coloring method " + method + "\n");
+  }
+  Coloring C = T->color(which, threads);
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  T->getArrays(x, y, conn);
+  std::ostringstream s;
+  s << T->fileRoot(outFile) << ": " << method << " coloring, "
+    << C.numColors() << " colors, sizes";
+  for (unsigned c = 0; c < C.numColors(); c++) {
+    s << (c == 0 ? " " : "/") << C.colorEnd(c) - C.colorBegin(c);
+  }
+  s << (C.isValid(conn) ? ", conflict free" : ", CONFLICTING");
+  return s.str();
+}
+
+std::string Mesh::printGraphs(const char *outFile) {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  T->getArrays(x, y, conn);
+  Graph nodeGraph = Graph::nodeGraph(conn, x.size());
+  Graph dualGraph = Graph::dualGraph(conn);
+  std::string root = T->fileRoot(outFile);
+  nodeGraph.printMetis((root + ".nodes.graph").c_str());
+  dualGraph.printMetis((root + ".dual.graph").c_str());
+  std::ostringstream s;
+  s << root << ": node graph " << nodeGraph.size() << " vertices, "
+    << nodeGraph.numEdges() << " edges; dual graph " << dualGraph.size()
+    << " vertices, " << dualGraph.numEdges() << " edges";
+  return s.str();
+}
+
+std::string Mesh::compact(const char *outFile, bool binary) {
+  // Meshes the body grid without building Nodes, Elements or a
+  // Triangulation: the points go straight into a CompactMesh, which keeps
+  // the mesh Delaunay as it grows, so the arrays are all there ever is
+  if (body.size() == 0) {
+    throw noBody();
+  }
+  if (T != nullptr || nodes.size() != 0) {
+    throw std::invalid_argument("Mesh has already been built\n");
+  }
+  Trace::Span span("compact");
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  double x_min = (*body[0])[0], x_max = (*body[1])[0];
+  double y_min = (*body[0])[1], y_max = (*body[2])[1];
+  int nx = ceil((x_max - x_min) / x_size);
+  int ny = ceil((y_max - y_min) / y_size);
+  double dx = (x_max - x_min) / nx, dy = (y_max - y_min) / ny;
+  for (unsigned i = 0; i < body.size(); i++) {
+    delete body[i];
+  }
+  body.clear();
+  std::size_t total = (std::size_t)(nx + 1) * (ny + 1);
+  CompactMesh C(x_min, y_min, x_max, y_max, total);
+  // Coarse to fine: each level halves the cells along their longer side,
+  // so every node lands in the middle of an edge of a near square cell
+  // and its flips stay local. Column by column instead, a finished column
+  // faces empty space and each node flips more of it the larger the grid.
+  int stepX = 1, stepY = 1;
+  while (stepX < nx) {
+    stepX *= 2;
+  }
+  while (stepY < ny) {
+    stepY *= 2;
+  }
+  std::vector<uint32_t> gridID = {0, 1, 2, 3}; // Per node, corners first
+  gridID.reserve(total);
+  while (stepX > 1 || stepY > 1) {
+    int lastX = stepX, lastY = stepY;
+    if (stepY == 1 || (stepX > 1 && stepX * dx >= stepY * dy)) {
+      stepX /= 2;
+    } else {
+      stepY /= 2;
+    }
+    for (int j = 0;; j = std::min(j + stepX, nx)) {
+      for (int k = 0;; k = std::min(k + stepY, ny)) {
+        bool coarser = (j % lastX == 0 || j == nx) &&
+                       (k % lastY == 0 || k == ny);
+        if (!coarser && C.insert(j == nx ? x_max : dx * j + x_min,
+                                 k == ny ? y_max : dy * k + y_min)) {
+          gridID.push_back(gridNodeID(j, k, nx, ny) - 1);
+        }
+        if (k == ny) {
+          break;
+        }
+      }
+      if (j == nx) {
+        break;
+      }
+    }
+  }
+  // Number the nodes as createGrid would, closing the gaps of merged ones
+  std::vector<uint32_t> rank(total, 0);
+  for (unsigned i = 0; i < gridID.size(); i++) {
+    rank[gridID[i]] = 1;
+  }
+  for (std::size_t i = 0, next = 0; i < total; i++) {
+    std::size_t used = rank[i];
+    rank[i] = next;
+    next += used;
+  }
+  for (unsigned i = 0; i < gridID.size(); i++) {
+    gridID[i] = rank[gridID[i]];
+  }
+  C.renumber(gridID);
+  C.trim();
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  std::string root = std::string(outFile) + ".compact";
+  C.printMesh((root + ".msh").c_str());
+  if (binary) {
+    C.printBinary((root + ".bin").c_str());
+  }
+  std::ostringstream s;
+  s << root << ": " << C.numNodes() << " nodes, " << C.numElements()
+    << " elements, " << C.bytesPerTriangle() << " bytes/triangle, "
+    << C.numFlips() << " flips, " << C.numSkipped()
+    << " nodes merged by rounding, " << seconds << " s";
+  return s.str();
+}
+
+std::string Mesh::render(const char *outFile, const std::string &format,
+                         const std::string &metric, unsigned size,
+                         unsigned threads) {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  if (format != "ppm" && format != "png" && format != "svg") {
+    throw std::invalid_argument("Unknown image format `" + format + "`\n");
+  }
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  T->getArrays(x, y, conn);
+  Renderer R(x, y, conn, size);
+  if (!metric.empty()) {
+    // Shade from the worst element (red) to the ideal triangle (green)
+    Quality Q(x, y, conn, threads);
+    if (metric == "angle") {
+      R.shade(Q.getMetric(Quality::MIN_ANGLE), 0, 60);
+    } else if (metric == "aspect") {
+      R.shade(Q.getMetric(Quality::ASPECT_RATIO),
+              Q.max(Quality::ASPECT_RATIO), 1);
+    } else if (metric == "edge") {
+      R.shade(Q.getMetric(Quality::EDGE_RATIO), Q.max(Quality::EDGE_RATIO),
+              1);
+    } else if (metric == "area") {
+      R.shade(Q.getMetric(Quality::AREA), Q.min(Quality::AREA),
+              Q.max(Quality::AREA));
+    } else {
+      throw std::invalid_argument("Unknown shading metric `" + metric +
+                                  "`\n");
+    }
+  }
+  std::string root = T->fileRoot(outFile);
+  std::string imageFile = root + "." + format;
+  if (format == "svg") {
+    R.printSVG(imageFile.c_str());
+  } else {
+    R.rasterize(R.edgesVisible());
+    if (format == "ppm") {
+      R.printPPM(imageFile.c_str());
+    } else {
+      R.printPNG(imageFile.c_str());
+    }
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::ostringstream s;
+  s << root << ": rendered " << conn.size() / 3 << " elements to "
+    << imageFile << " (" << R.getWidth() << "x" << R.getHeight() << ") in "
+    << elapsed.count() << " s";
+  return s.str();
+}
+
+uint64_t Mesh::hash() const {
+  if (T == nullptr) {
+    throw noMesh();
+  }
+  return T->canonicalHash();
+}
+
+const Triangulation *Mesh::getTriangulation() const { return T; }
+
 // Protected methods
 void Mesh::createGrid(std::vector<Node *> &vertices, bool randFlag) {
   // Divide domain up into side lengths
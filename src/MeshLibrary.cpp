@@ -0,0 +1,35 @@
+#include "../include/MeshLibrary.h"
+
+void meshRectangle(double xMin, double yMin, double xMax, double yMax,
+                   double xSize, double ySize, std::vector<double> &x,
+                   std::vector<double> &y, std::vector<unsigned> &conn,
+                   bool delaunay) {
+  Body inputBody(xSize, ySize, xMin, yMin, xMax, yMax);
+  Mesh meshedBody(inputBody);
+  meshedBody.mesh();
+  if (delaunay) {
+    meshedBody.Delaunay();
+  }
+  meshedBody.getTriangulation()->getArrays(x, y, conn);
+}
+
+void meshPoints(const std::vector<double> &px, const std::vector<double> &py,
+                std::vector<double> &x, std::vector<double> &y,
+                std::vector<unsigned> &conn, bool delaunay) {
+  if (px.size() == 0 || px.size() != py.size()) {
+    throw std::invalid_argument("Point x and y arrays differ in length or "
+                                "are empty\n");
+  }
+  double xMin = *std::min_element(px.begin(), px.end());
+  double xMax = *std::max_element(px.begin(), px.end());
+  double yMin = *std::min_element(py.begin(), py.end());
+  double yMax = *std::max_element(py.begin(), py.end());
+  // The grid spacing is not used when the points are given
+  Body inputBody(1, 1, xMin, yMin, xMax, yMax);
+  Mesh meshedBody(inputBody);
+  meshedBody.mesh(px, py);
+  if (delaunay) {
+    meshedBody.Delaunay();
+  }
+  meshedBody.getTriangulation()->getArrays(x, y, conn);
+}
@@ -3,18 +3,15 @@
 // Initializer for member variable
 unsigned Node::nextNodeID = 1;
 
+namespace {
+const unsigned smallFan = 8; // Edges scanned before they are looked up
+} // namespace
+
 // Constructors
 Node::Node(double x, double y) {
   nodeID = nextNodeID;
   nextNodeID++;
-  coords = {x, y};
-}
-
-Node::Node(const Node &rhs) {
-  nodeID = nextNodeID;
-  nextNodeID++;
-  coords = {rhs[0], rhs[1]};
-  edges = rhs.sourceNode();
+  coords = Point2d(x, y);
 }
 
 // Destructor
@@ -25,24 +22,8 @@ Node::~Node() {
 }
 
 // Operators
-Node &Node::operator=(const Node &rhs) {
-  if (&rhs != this) {
-    Node temp = rhs;
-    unsigned id = nodeID;
-    std::vector<double> c = coords;
-    std::vector<Edge *> e = edges;
-    nodeID = temp.nodeID;
-    coords = temp.coords;
-    edges = temp.edges;
-    temp.nodeID = id;
-    temp.coords = c;
-    temp.edges = e;
-  }
-  return *this;
-}
-
 double Node::operator[](int index) {
-  if (index >= (int)coords.size() || index < 0) {
+  if (index >= (int)Point2d::size() || index < 0) {
     throw std::invalid_argument("Index out of bounds in node\n");
   } else {
     return coords[index];
@@ -50,7 +31,7 @@ double Node::operator[](int index) {
 }
 
 const double Node::operator[](int index) const {
-  if (index >= (int)coords.size() || index < 0) {
+  if (index >= (int)Point2d::size() || index < 0) {
     throw std::invalid_argument("Index out of bounds in node\n");
   } else {
     return coords[index];
@@ -62,37 +43,30 @@ std::ostream &operator<<(std::ostream &s, const Node *rhs) {
   return s;
 }
 
-std::vector<double> &operator*(std::vector<double> &v, double c) {
-  for (unsigned i = 0; i < v.size(); i++) {
-    v[i] *= c;
-  }
-  return v;
-}
+// Public methods
+unsigned Node::getID() const { return nodeID; }
 
-std::vector<double> &operator+(std::vector<double> &v1,
-                               std::vector<double> &v2) {
-  assert(v1.size() == v2.size());
-  for (unsigned i = 0; i < v1.size(); i++) {
-    v1[i] += v2[i];
-  }
-  return v1;
-}
+const Point2d &Node::getPoint() const { return coords; }
+
+void Node::setID(unsigned newID) { nodeID = newID; }
 
-std::vector<double> &operator-(std::vector<double> &v1,
-                               std::vector<double> &v2) {
-  assert(v1.size() == v2.size());
-  for (unsigned i = 0; i < v1.size(); i++) {
-    v1[i] -= v2[i];
+void Node::moveTo(double x, double y) {
+  // Edges cache their vector and length, so refresh the ones leaving this
+  // node and the ones pointing back at it
+  coords = Point2d(x, y);
+  for (unsigned i = 0; i < edges.size(); i++) {
+    edges[i]->updateVector();
+    Edge *back = edges[i]->getSink()->edgeTo(this);
+    if (back != nullptr) {
+      back->updateVector();
+    }
   }
-  return v1;
 }
 
-// Public methods
-unsigned Node::getID() const { return nodeID; }
-
 void Node::connect(Node *otherNode) {
   if (!isConnected(otherNode)) {
     edges.push_back(new Edge(this, otherNode));
+    index(otherNode, edges.size() - 1);
   }
   if (!otherNode->isConnected(this)) {
     otherNode->connect(this);
@@ -100,25 +74,45 @@ void Node::connect(Node *otherNode) {
 }
 
 bool Node::isConnected(Node *otherNode) {
-  for (unsigned i = 0; i < edges.size(); i++) {
-    if (edges[i]->getSink() == otherNode) {
-      return true;
-    }
-  }
-  return false;
+  return slotOf(otherNode) != edges.size();
 }
 
 void Node::disconnect(Node *otherNode) {
-  for (unsigned i = 0; i < edges.size(); i++) {
-    if (edges[i]->getSink() == otherNode) {
-      delete edges[i];
-      edges.erase(edges.begin() + i);
-      if (otherNode->isConnected(this)) {
-        otherNode->disconnect(this);
-      }
-      break;
+  unsigned i = slotOf(otherNode);
+  if (i == edges.size()) {
+    return;
+  }
+  // The last edge fills the gap, the order of the edges means nothing
+  delete edges[i];
+  edges[i] = edges.back();
+  edges.pop_back();
+  if (!slots.empty()) {
+    slots.erase(otherNode);
+    if (i < edges.size()) {
+      slots[edges[i]->getSink()] = i;
     }
   }
+  if (otherNode->isConnected(this)) {
+    otherNode->disconnect(this);
+  }
+}
+
+Edge *Node::edgeTo(Node *otherNode) const {
+  unsigned i = slotOf(otherNode);
+  return i == edges.size() ? nullptr : edges[i];
+}
+
+void Node::redirect(Node *oldSink, Node *newSink) {
+  unsigned i = slotOf(oldSink);
+  if (i == edges.size()) {
+    return;
+  }
+  edges[i]->sink = newSink;
+  edges[i]->updateVector();
+  if (!slots.empty()) {
+    slots.erase(oldSink);
+    slots[newSink] = i;
+  }
 }
 
 double Node::distanceTo(Node *node) {
@@ -126,30 +120,67 @@ double Node::distanceTo(Node *node) {
 }
 
 double Node::distanceTo(Edge *edge) {
-  Edge *toSource = new Edge(this, edge->getSource());
-  std::vector<double> unitToSource = toSource->normalize();
-  double l = toSource->getLength();
+  Vec2d toSource = edge->getSource()->getPoint() - coords;
+  double l = toSource.length();
+  Vec2d unitToSource = toSource / l;
   double parallelComp = (*edge) % unitToSource;
   if (fabs(l * parallelComp) >= edge->getLength() || parallelComp >= 0) {
-    delete toSource;
     return INFTY;
   }
-  std::vector<double> unitEdge = edge->normalize();
-  std::vector<double> unitToEdge = unitToSource - (unitEdge * parallelComp);
-  double ans = 0;
-  for (unsigned i = 0; i < unitToEdge.size(); i++) {
-    ans += pow(unitToEdge[i], 2);
-  }
-  delete toSource;
-  return l * sqrt(ans);
+  Vec2d unitToEdge = unitToSource - edge->normalize() * parallelComp;
+  return l * unitToEdge.length();
 }
 
 bool Node::isOnEdge(Node *node1, Node *node2) {
-  Edge test(node1, node2);
-  if (distanceTo(&test) < 1e-15) {
-    return true;
+  // Off the line by less than a small fraction of the edge length, and
+  // strictly between the end points. Grid nodes meant to be on an edge are
+  // rarely exactly on it once rounded, and an absolute tolerance stops
+  // catching them once coordinates grow much beyond 1.
+  Vec2d e = node2->getPoint() - node1->getPoint();
+  Vec2d p = coords - node1->getPoint();
+  double lengthSq = e.lengthSq();
+  if (fabs(cross(e, p)) >= 1e-12 * lengthSq) {
+    return false;
+  }
+  double along = e.dot(p);
+  return along > 0 && along < lengthSq;
+}
+
+const std::vector<Edge *> &Node::sourceNode() const { return edges; }
+
+std::size_t Node::memoryBytes() const {
+  // Lookup entries are counted as a key, a value and a bucket pointer each
+  return sizeof(Node) + edges.capacity() * sizeof(Edge *) +
+         edges.size() * sizeof(Edge) +
+         slots.size() * (sizeof(Node *) + sizeof(unsigned) + sizeof(void *));
+}
+
+// Protected methods
+unsigned Node::slotOf(Node *otherNode) const {
+  // Small fans are scanned. Larger ones, like a corner joined to most of a
+  // grid, are looked up, so any node finds an edge in constant time.
+  if (slots.empty()) {
+    for (unsigned i = 0; i < edges.size(); i++) {
+      if (edges[i]->getSink() == otherNode) {
+        return i;
+      }
+    }
+    return edges.size();
   }
-  return false;
+  std::unordered_map<Node *, unsigned>::const_iterator it =
+      slots.find(otherNode);
+  return it == slots.end() ? edges.size() : it->second;
 }
 
-std::vector<Edge *> Node::sourceNode() const { return edges; }
+void Node::index(Node *sink, unsigned i) {
+  // Once built, the lookup holds every edge until the node has none left
+  if (slots.empty() && edges.size() <= smallFan) {
+    return;
+  }
+  if (slots.empty()) {
+    for (unsigned j = 0; j < edges.size(); j++) {
+      slots[edges[j]->getSink()] = j;
+    }
+  }
+  slots[sink] = i;
+}
@@ -0,0 +1,274 @@
+#include "../include/Partition.h"
+
+// Constructors
+Partition::Partition(const std::vector<double> &xIn,
+                     const std::vector<double> &yIn,
+                     const std::vector<unsigned> &connIn, unsigned k,
+                     bool inertial) {
+  x = xIn;
+  y = yIn;
+  conn = connIn;
+  numParts = k;
+  unsigned n = conn.size() / 3;
+  if (k == 0 || k > n) {
+    throw std::invalid_argument(
+        "Number of parts must be between 1 and the number of elements\n");
+  }
+  cx.resize(n);
+  cy.resize(n);
+  for (unsigned i = 0; i < n; i++) {
+    cx[i] = (x[conn[3 * i]] + x[conn[3 * i + 1]] + x[conn[3 * i + 2]]) / 3;
+    cy[i] = (y[conn[3 * i]] + y[conn[3 * i + 1]] + y[conn[3 * i + 2]]) / 3;
+  }
+  neighbors = EdgeTable(conn).getNeighbors();
+  parts.assign(n, 0);
+  std::vector<unsigned> elems(n);
+  for (unsigned i = 0; i < n; i++) {
+    elems[i] = i;
+  }
+  bisect(elems, 0, n, 0, k, inertial);
+  initialCut = edgeCut();
+  refine(0.03);
+}
+
+// Public methods
+unsigned Partition::size() const { return numParts; }
+
+const std::vector<unsigned> &Partition::getParts() const { return parts; }
+
+unsigned Partition::edgeCut() const {
+  unsigned cut = 0;
+  for (unsigned i = 0; i < parts.size(); i++) {
+    for (int k = 0; k < 3; k++) {
+      int j = neighbors[3 * i + k];
+      if (j > (int)i && parts[j] != parts[i]) {
+        cut++;
+      }
+    }
+  }
+  return cut;
+}
+
+unsigned Partition::edgeCutBeforeRefinement() const { return initialCut; }
+
+std::vector<unsigned> Partition::partSizes() const {
+  std::vector<unsigned> sizes(numParts, 0);
+  for (unsigned i = 0; i < parts.size(); i++) {
+    sizes[parts[i]]++;
+  }
+  return sizes;
+}
+
+void Partition::write(const std::string &root,
+                      const std::vector<unsigned> &nodeIDs,
+                      const std::vector<unsigned> &elemIDs) const {
+  // One file per part: its elements, one layer of halo elements (those
+  // sharing a node with the part), and maps from local to global numbers
+  unsigned n = parts.size();
+  unsigned numNodes = x.size();
+  // Node to element incidence (CSR), and the owner of each node, which is
+  // the lowest numbered part touching it
+  std::vector<unsigned> start(numNodes + 1, 0), incident(conn.size());
+  std::vector<unsigned> owner(numNodes, numParts);
+  for (unsigned i = 0; i < conn.size(); i++) {
+    start[conn[i] + 1]++;
+    owner[conn[i]] = std::min(owner[conn[i]], parts[i / 3]);
+  }
+  for (unsigned i = 0; i < numNodes; i++) {
+    start[i + 1] += start[i];
+  }
+  std::vector<unsigned> fill(start.begin(), start.end() - 1);
+  for (unsigned i = 0; i < conn.size(); i++) {
+    incident[fill[conn[i]]++] = i / 3;
+  }
+  std::vector<int> local(numNodes, -1);
+  std::vector<unsigned> haloStamp(n, numParts);
+  for (unsigned p = 0; p < numParts; p++) {
+    std::vector<unsigned> owned, halo, localNodes;
+    for (unsigned i = 0; i < n; i++) {
+      if (parts[i] == p) {
+        owned.push_back(i);
+      }
+    }
+    for (unsigned i = 0; i < owned.size(); i++) {
+      for (int k = 0; k < 3; k++) {
+        unsigned node = conn[3 * owned[i] + k];
+        for (unsigned m = start[node]; m < start[node + 1]; m++) {
+          unsigned e = incident[m];
+          if (parts[e] != p && haloStamp[e] != p) {
+            haloStamp[e] = p;
+            halo.push_back(e);
+          }
+        }
+      }
+    }
+    sort(halo.begin(), halo.end());
+    // Local node numbers: nodes of owned elements first, then halo nodes
+    for (int pass = 0; pass < 2; pass++) {
+      const std::vector<unsigned> &elems = pass == 0 ? owned : halo;
+      for (unsigned i = 0; i < elems.size(); i++) {
+        for (int k = 0; k < 3; k++) {
+          unsigned node = conn[3 * elems[i] + k];
+          if (local[node] == -1) {
+            local[node] = localNodes.size();
+            localNodes.push_back(node);
+          }
+        }
+      }
+    }
+    std::ostringstream name;
+    name << root << ".part" << p << ".msh";
+    std::ofstream w(name.str().c_str());
+    if (!(w.is_open())) {
+      fprintf(stderr, "Error opening %s", name.str().c_str());
+      exit(EXIT_FAILURE);
+    }
+    w << "$partition\n" << p << "," << numParts << "\n";
+    w << "$nodes\n";
+    for (unsigned i = 0; i < localNodes.size(); i++) {
+      w << i + 1 << "," << x[localNodes[i]] << "," << y[localNodes[i]]
+        << "\n";
+    }
+    w << "$elements\n";
+    for (unsigned i = 0; i < owned.size(); i++) {
+      w << i + 1;
+      for (int k = 0; k < 3; k++) {
+        w << "," << local[conn[3 * owned[i] + k]] + 1;
+      }
+      w << "\n";
+    }
+    w << "$halo\n";
+    for (unsigned i = 0; i < halo.size(); i++) {
+      w << owned.size() + i + 1;
+      for (int k = 0; k < 3; k++) {
+        w << "," << local[conn[3 * halo[i] + k]] + 1;
+      }
+      w << "," << parts[halo[i]] << "\n";
+    }
+    w << "$nodemap\n";
+    for (unsigned i = 0; i < localNodes.size(); i++) {
+      w << i + 1 << "," << nodeIDs[localNodes[i]] << ","
+        << owner[localNodes[i]] << "\n";
+    }
+    w << "$elementmap\n";
+    for (unsigned i = 0; i < owned.size(); i++) {
+      w << i + 1 << "," << elemIDs[owned[i]] << "\n";
+    }
+    for (unsigned i = 0; i < halo.size(); i++) {
+      w << owned.size() + i + 1 << "," << elemIDs[halo[i]] << "\n";
+    }
+    w.close();
+    for (unsigned i = 0; i < localNodes.size(); i++) {
+      local[localNodes[i]] = -1;
+    }
+  }
+}
+
+// Protected methods
+void Partition::bisect(std::vector<unsigned> &elems, unsigned begin,
+                       unsigned end, unsigned firstPart, unsigned count,
+                       bool inertial) {
+  if (count == 1) {
+    for (unsigned i = begin; i < end; i++) {
+      parts[elems[i]] = firstPart;
+    }
+    return;
+  }
+  // Cut direction: the longest side of the bounding box, or the principal
+  // axis of the centroids' second moments for inertial bisection
+  double dirX = 1, dirY = 0;
+  if (inertial) {
+    double mx = 0, my = 0;
+    for (unsigned i = begin; i < end; i++) {
+      mx += cx[elems[i]];
+      my += cy[elems[i]];
+    }
+    mx /= end - begin;
+    my /= end - begin;
+    double sxx = 0, syy = 0, sxy = 0;
+    for (unsigned i = begin; i < end; i++) {
+      double dx = cx[elems[i]] - mx, dy = cy[elems[i]] - my;
+      sxx += dx * dx;
+      syy += dy * dy;
+      sxy += dx * dy;
+    }
+    double angle = 0.5 * std::atan2(2 * sxy, sxx - syy);
+    dirX = std::cos(angle);
+    dirY = std::sin(angle);
+  } else {
+    double xMin = cx[elems[begin]], xMax = xMin;
+    double yMin = cy[elems[begin]], yMax = yMin;
+    for (unsigned i = begin; i < end; i++) {
+      xMin = std::min(xMin, cx[elems[i]]);
+      xMax = std::max(xMax, cx[elems[i]]);
+      yMin = std::min(yMin, cy[elems[i]]);
+      yMax = std::max(yMax, cy[elems[i]]);
+    }
+    if (yMax - yMin > xMax - xMin) {
+      dirX = 0;
+      dirY = 1;
+    }
+  }
+  // Split the element count in proportion to the parts on each side
+  unsigned leftParts = count / 2;
+  unsigned mid = begin + (unsigned long long)(end - begin) * leftParts / count;
+  std::vector<std::pair<double, unsigned>> keys;
+  keys.reserve(end - begin);
+  for (unsigned i = begin; i < end; i++) {
+    keys.push_back(std::make_pair(
+        cx[elems[i]] * dirX + cy[elems[i]] * dirY, elems[i]));
+  }
+  std::nth_element(keys.begin(), keys.begin() + (mid - begin), keys.end());
+  for (unsigned i = begin; i < end; i++) {
+    elems[i] = keys[i - begin].second;
+  }
+  bisect(elems, begin, mid, firstPart, leftParts, inertial);
+  bisect(elems, mid, end, firstPart + leftParts, count - leftParts, inertial);
+}
+
+void Partition::refine(double imbalance) {
+  // Move an element to the neighboring part it shares most edges with,
+  // when that strictly lowers the cut and keeps sizes within the bound
+  unsigned n = parts.size();
+  std::vector<unsigned> sizes = partSizes();
+  unsigned maxSize = (unsigned)std::ceil((1 + imbalance) * n / numParts);
+  unsigned minSize = (unsigned)std::floor((1 - imbalance) * n / numParts);
+  for (int pass = 0; pass < 8; pass++) {
+    unsigned moves = 0;
+    for (unsigned i = 0; i < n; i++) {
+      unsigned p = parts[i];
+      unsigned best = p;
+      int bestGain = 0;
+      for (int k = 0; k < 3; k++) {
+        int j = neighbors[3 * i + k];
+        if (j == -1 || parts[j] == p) {
+          continue;
+        }
+        unsigned q = parts[j];
+        int gain = 0;
+        for (int m = 0; m < 3; m++) {
+          int l = neighbors[3 * i + m];
+          if (l != -1 && parts[l] == q) {
+            gain++;
+          } else if (l != -1 && parts[l] == p) {
+            gain--;
+          }
+        }
+        if (gain > bestGain && sizes[q] + 1 <= maxSize &&
+            sizes[p] - 1 >= minSize) {
+          best = q;
+          bestGain = gain;
+        }
+      }
+      if (best != p) {
+        parts[i] = best;
+        sizes[p]--;
+        sizes[best]++;
+        moves++;
+      }
+    }
+    if (moves == 0) {
+      break;
+    }
+  }
+}
@@ -0,0 +1,239 @@
+#include "../include/Predicates.h"
+
+// An expansion is a sum of non-overlapping doubles, stored in increasing
+// order of magnitude. Only the exact fallback paths below build them.
+typedef std::vector<double> Expansion;
+
+// Error bounds of the floating point filters (Shewchuk, section 4)
+static const double epsilon = std::ldexp(1.0, -53);
+static const double splitter = std::ldexp(1.0, 27) + 1.0;
+static const double ccwErrBound = (3.0 + 16.0 * epsilon) * epsilon;
+static const double iccErrBound = (10.0 + 96.0 * epsilon) * epsilon;
+
+static void fastTwoSum(double a, double b, double &x, double &y) {
+  x = a + b;
+  double bVirtual = x - a;
+  y = b - bVirtual;
+}
+
+static void twoSum(double a, double b, double &x, double &y) {
+  x = a + b;
+  double bVirtual = x - a;
+  double aVirtual = x - bVirtual;
+  y = (a - aVirtual) + (b - bVirtual);
+}
+
+static void twoDiff(double a, double b, double &x, double &y) {
+  x = a - b;
+  double bVirtual = a - x;
+  double aVirtual = x + bVirtual;
+  y = (a - aVirtual) + (bVirtual - b);
+}
+
+static void split(double a, double &hi, double &lo) {
+  double c = splitter * a;
+  double aBig = c - a;
+  hi = c - aBig;
+  lo = a - hi;
+}
+
+static void twoProduct(double a, double b, double &x, double &y) {
+  x = a * b;
+  double aHi, aLo, bHi, bLo;
+  split(a, aHi, aLo);
+  split(b, bHi, bLo);
+  double err1 = x - aHi * bHi;
+  double err2 = err1 - aLo * bHi;
+  double err3 = err2 - aHi * bLo;
+  y = aLo * bLo - err3;
+}
+
+static Expansion difference(double a, double b) {
+  double x, y;
+  twoDiff(a, b, x, y);
+  Expansion ans;
+  if (y != 0) {
+    ans.push_back(y);
+  }
+  if (x != 0) {
+    ans.push_back(x);
+  }
+  return ans;
+}
+
+static Expansion grow(const Expansion &e, double b) {
+  Expansion h;
+  h.reserve(e.size() + 1);
+  double q = b;
+  for (unsigned i = 0; i < e.size(); i++) {
+    double hh;
+    twoSum(q, e[i], q, hh);
+    if (hh != 0) {
+      h.push_back(hh);
+    }
+  }
+  if (q != 0) {
+    h.push_back(q);
+  }
+  return h;
+}
+
+static Expansion sum(const Expansion &e, const Expansion &f) {
+  Expansion h = e;
+  for (unsigned i = 0; i < f.size(); i++) {
+    h = grow(h, f[i]);
+  }
+  return h;
+}
+
+static Expansion scale(const Expansion &e, double b) {
+  Expansion h;
+  if (e.size() == 0 || b == 0) {
+    return h;
+  }
+  h.reserve(2 * e.size());
+  double q, hh;
+  twoProduct(e[0], b, q, hh);
+  if (hh != 0) {
+    h.push_back(hh);
+  }
+  for (unsigned i = 1; i < e.size(); i++) {
+    double p1, p0, s;
+    twoProduct(e[i], b, p1, p0);
+    twoSum(q, p0, s, hh);
+    if (hh != 0) {
+      h.push_back(hh);
+    }
+    fastTwoSum(p1, s, q, hh);
+    if (hh != 0) {
+      h.push_back(hh);
+    }
+  }
+  if (q != 0) {
+    h.push_back(q);
+  }
+  return h;
+}
+
+static Expansion product(const Expansion &e, const Expansion &f) {
+  Expansion h;
+  for (unsigned i = 0; i < f.size(); i++) {
+    h = sum(h, scale(e, f[i]));
+  }
+  return h;
+}
+
+static Expansion negate(Expansion e) {
+  for (unsigned i = 0; i < e.size(); i++) {
+    e[i] = -e[i];
+  }
+  return e;
+}
+
+static double mostSignificant(const Expansion &e) {
+  return e.size() == 0 ? 0 : e.back();
+}
+
+static double orient2dExact(double ax, double ay, double bx, double by,
+                            double cx, double cy) {
+  Expansion acx = difference(ax, cx), acy = difference(ay, cy);
+  Expansion bcx = difference(bx, cx), bcy = difference(by, cy);
+  return mostSignificant(
+      sum(product(acx, bcy), negate(product(acy, bcx))));
+}
+
+static double incircleExact(double ax, double ay, double bx, double by,
+                            double cx, double cy, double dx, double dy) {
+  Expansion adx = difference(ax, dx), ady = difference(ay, dy);
+  Expansion bdx = difference(bx, dx), bdy = difference(by, dy);
+  Expansion cdx = difference(cx, dx), cdy = difference(cy, dy);
+  Expansion aLift = sum(product(adx, adx), product(ady, ady));
+  Expansion bLift = sum(product(bdx, bdx), product(bdy, bdy));
+  Expansion cLift = sum(product(cdx, cdx), product(cdy, cdy));
+  Expansion bc = sum(product(bdx, cdy), negate(product(bdy, cdx)));
+  Expansion ca = sum(product(cdx, ady), negate(product(cdy, adx)));
+  Expansion ab = sum(product(adx, bdy), negate(product(ady, bdx)));
+  Expansion det = sum(sum(product(aLift, bc), product(bLift, ca)),
+                      product(cLift, ab));
+  return mostSignificant(det);
+}
+
+double orient2d(double ax, double ay, double bx, double by, double cx,
+                double cy) {
+  double detLeft = (ax - cx) * (by - cy);
+  double detRight = (ay - cy) * (bx - cx);
+  double det = detLeft - detRight;
+  // Terms of opposite sign cannot cancel, so the sign is already right
+  if ((detLeft > 0 && detRight <= 0) || (detLeft < 0 && detRight >= 0) ||
+      detLeft == 0) {
+    return det;
+  }
+  double errBound = ccwErrBound * std::fabs(detLeft + detRight);
+  if (det >= errBound || -det >= errBound) {
+    return det;
+  }
+  return orient2dExact(ax, ay, bx, by, cx, cy);
+}
+
+double incircle(double ax, double ay, double bx, double by, double cx,
+                double cy, double dx, double dy) {
+  double adx = ax - dx, ady = ay - dy;
+  double bdx = bx - dx, bdy = by - dy;
+  double cdx = cx - dx, cdy = cy - dy;
+  double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+  double cdxady = cdx * ady, adxcdy = adx * cdy;
+  double adxbdy = adx * bdy, bdxady = bdx * ady;
+  double aLift = adx * adx + ady * ady;
+  double bLift = bdx * bdx + bdy * bdy;
+  double cLift = cdx * cdx + cdy * cdy;
+  double det = aLift * (bdxcdy - cdxbdy) + bLift * (cdxady - adxcdy) +
+               cLift * (adxbdy - bdxady);
+  double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * aLift +
+                     (std::fabs(cdxady) + std::fabs(adxcdy)) * bLift +
+                     (std::fabs(adxbdy) + std::fabs(bdxady)) * cLift;
+  double errBound = iccErrBound * permanent;
+  if (det > errBound || -det > errBound) {
+    return det;
+  }
+  return incircleExact(ax, ay, bx, by, cx, cy, dx, dy);
+}
+
+static bool precedes(const Point2d &p, unsigned pID, const Point2d &q,
+                     unsigned qID) {
+  // Total order on the points by coordinates, id only for coincident ones.
+  // Earlier points carry the larger symbolic perturbation. With y
+  // descending a grid cell keeps its lower-left to upper-right diagonal,
+  // the one the split mesher mostly builds already, so few ties need a flip.
+  if (p[0] != q[0]) {
+    return p[0] < q[0];
+  }
+  if (p[1] != q[1]) {
+    return p[1] > q[1];
+  }
+  return pID < qID;
+}
+
+bool isLocallyDelaunay(const Point2d pts[4], const unsigned ids[4]) {
+  // The sign comes from the exact predicate, so rounding never decides
+  double inside = incircle(pts[0], pts[1], pts[2], pts[3]);
+  if (orient2d(pts[0], pts[1], pts[2]) < 0) {
+    inside = -inside;
+  }
+  if (inside != 0) {
+    return inside < 0;
+  }
+  // Cocircular: simulation of simplicity. On the paraboloid op2 is inside
+  // while it lies below the plane through s0, s1, op1. Raise each point by
+  // a symbolic eps^k, k its rank under precedes(), so the earliest of the
+  // four decides: raising op2 lifts it above the plane, raising op1 tilts
+  // the plane down at op2 (across the diagonal), raising s0 or s1 tilts it
+  // up. The lifting is generic, so its Delaunay mesh is unique and any
+  // flip order reaches it; the diagonal kept avoids the earliest point.
+  int first = 0;
+  for (int k = 1; k < 4; k++) {
+    if (precedes(pts[k], ids[k], pts[first], ids[first])) {
+      first = k;
+    }
+  }
+  return first >= 2;
+}
@@ -0,0 +1,182 @@
+#include "../include/Quality.h"
+
+// Constructors
+Quality::Quality(const Triangulation &T, unsigned threads) {
+  numThreads = std::max(threads, 1u);
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  T.getArrays(x, y, conn);
+  compute(x, y, conn);
+}
+
+Quality::Quality(const std::vector<double> &x, const std::vector<double> &y,
+                 const std::vector<unsigned> &conn, unsigned threads) {
+  numThreads = std::max(threads, 1u);
+  compute(x, y, conn);
+}
+
+// Public methods
+unsigned Quality::size() const { return minAngle.size(); }
+
+const std::vector<double> &Quality::getMetric(Metric which) const {
+  switch (which) {
+  case MIN_ANGLE:
+    return minAngle;
+  case ASPECT_RATIO:
+    return aspectRatio;
+  case AREA:
+    return area;
+  default:
+    return edgeRatio;
+  }
+}
+
+double Quality::min(Metric which) const {
+  const std::vector<double> &m = getMetric(which);
+  if (m.size() == 0) {
+    throw std::invalid_argument("No elements to measure\n");
+  }
+  return *std::min_element(m.begin(), m.end());
+}
+
+double Quality::max(Metric which) const {
+  const std::vector<double> &m = getMetric(which);
+  if (m.size() == 0) {
+    throw std::invalid_argument("No elements to measure\n");
+  }
+  return *std::max_element(m.begin(), m.end());
+}
+
+double Quality::mean(Metric which) const {
+  const std::vector<double> &m = getMetric(which);
+  if (m.size() == 0) {
+    throw std::invalid_argument("No elements to measure\n");
+  }
+  double sum = 0;
+  for (unsigned i = 0; i < m.size(); i++) {
+    sum += m[i];
+  }
+  return sum / m.size();
+}
+
+std::vector<unsigned> Quality::histogram(Metric which, double lo, double hi,
+                                         unsigned bins) const {
+  // Values outside [lo, hi) are counted in the first or last bin
+  const std::vector<double> &m = getMetric(which);
+  std::vector<unsigned> counts(bins, 0);
+  double width = (hi - lo) / bins;
+  for (unsigned i = 0; i < m.size(); i++) {
+    double b = std::floor((m[i] - lo) / width);
+    b = std::max(0.0, std::min(b, (double)(bins - 1)));
+    counts[(unsigned)b]++;
+  }
+  return counts;
+}
+
+std::string Quality::summary() const {
+  std::ostringstream s;
+  s << size() << " elements, min angle " << min(MIN_ANGLE) << " (mean "
+    << mean(MIN_ANGLE) << "), aspect ratio " << max(ASPECT_RATIO) << " (mean "
+    << mean(ASPECT_RATIO) << "), area " << min(AREA) << " to " << max(AREA)
+    << ", edge ratio " << max(EDGE_RATIO);
+  return s.str();
+}
+
+void Quality::printReport(const char *outFile) const {
+  std::ofstream w(outFile);
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", outFile);
+    exit(EXIT_FAILURE);
+  }
+  w << "$summary\n" << summary() << "\n";
+  // Minimum angle cannot exceed 60 degrees, so bin it in 5 degree steps
+  std::vector<unsigned> h = histogram(MIN_ANGLE, 0, 60, 12);
+  w << "$minangle\n";
+  for (unsigned i = 0; i < h.size(); i++) {
+    w << 5 * i << "," << 5 * (i + 1) << "," << h[i] << "\n";
+  }
+  // Aspect ratio is 1 for an equilateral triangle, last bin is open ended
+  h = histogram(ASPECT_RATIO, 1, 3, 10);
+  w << "$aspectratio\n";
+  for (unsigned i = 0; i < h.size(); i++) {
+    w << 1 + 0.2 * i << "," << 1 + 0.2 * (i + 1) << "," << h[i] << "\n";
+  }
+  h = histogram(EDGE_RATIO, 1, 3, 10);
+  w << "$edgeratio\n";
+  for (unsigned i = 0; i < h.size(); i++) {
+    w << 1 + 0.2 * i << "," << 1 + 0.2 * (i + 1) << "," << h[i] << "\n";
+  }
+  w.close();
+}
+
+// Protected methods
+void Quality::compute(const std::vector<double> &x,
+                      const std::vector<double> &y,
+                      const std::vector<unsigned> &conn) {
+  unsigned n = conn.size() / 3;
+  // Gather vertex coordinates per element, so the kernel reads contiguous
+  // arrays and does not have to chase indices
+  std::vector<double> ax(n), ay(n), bx(n), by(n), cx(n), cy(n);
+  for (unsigned i = 0; i < n; i++) {
+    ax[i] = x[conn[3 * i]];
+    ay[i] = y[conn[3 * i]];
+    bx[i] = x[conn[3 * i + 1]];
+    by[i] = y[conn[3 * i + 1]];
+    cx[i] = x[conn[3 * i + 2]];
+    cy[i] = y[conn[3 * i + 2]];
+  }
+  minAngle.resize(n);
+  aspectRatio.resize(n);
+  area.resize(n);
+  edgeRatio.resize(n);
+  // Threads only pay off on large meshes, give each a decent chunk
+  unsigned threads = std::min(numThreads, std::max(n / 65536, 1u));
+  if (threads <= 1) {
+    computeRange(ax.data(), ay.data(), bx.data(), by.data(), cx.data(),
+                 cy.data(), 0, n);
+    return;
+  }
+  std::vector<std::thread> pool;
+  unsigned chunk = (n + threads - 1) / threads;
+  for (unsigned t = 0; t < threads; t++) {
+    unsigned begin = t * chunk;
+    unsigned end = std::min(n, begin + chunk);
+    pool.push_back(std::thread(&Quality::computeRange, this, ax.data(),
+                               ay.data(), bx.data(), by.data(), cx.data(),
+                               cy.data(), begin, end));
+  }
+  for (unsigned t = 0; t < pool.size(); t++) {
+    pool[t].join();
+  }
+}
+
+void Quality::computeRange(const double *ax, const double *ay,
+                           const double *bx, const double *by,
+                           const double *cx, const double *cy, unsigned begin,
+                           unsigned end) {
+  Trace::Span span("quality range", "worker");
+  const double toDegrees = 180 / M_PI;
+  double *minA = minAngle.data();
+  double *aspect = aspectRatio.data();
+  double *ar = area.data();
+  double *ratio = edgeRatio.data();
+  // Straight-line arithmetic on each element, no branches in the loop body
+  for (unsigned i = begin; i < end; i++) {
+    double abx = bx[i] - ax[i], aby = by[i] - ay[i];
+    double acx = cx[i] - ax[i], acy = cy[i] - ay[i];
+    double bcx = cx[i] - bx[i], bcy = cy[i] - by[i];
+    double c2 = abx * abx + aby * aby; // Squared edge lengths, opposite
+    double b2 = acx * acx + acy * acy; // the vertex of the same name
+    double a2 = bcx * bcx + bcy * bcy;
+    double cross = std::fabs(abx * acy - aby * acx); // Twice the area
+    double angleA = std::atan2(cross, abx * acx + aby * acy);
+    double angleB = std::atan2(cross, -abx * bcx - aby * bcy);
+    double angleC = M_PI - angleA - angleB;
+    double a = std::sqrt(a2), b = std::sqrt(b2), c = std::sqrt(c2);
+    minA[i] = std::min(angleA, std::min(angleB, angleC)) * toDegrees;
+    ar[i] = 0.5 * cross;
+    // R / 2r = abc (a + b + c) / (16 A^2), with 16 A^2 = 4 cross^2
+    aspect[i] = a * b * c * (a + b + c) / (4 * cross * cross);
+    ratio[i] = std::max(a, std::max(b, c)) / std::min(a, std::min(b, c));
+  }
+}
@@ -0,0 +1,265 @@
+#include "../include/Renderer.h"
+
+namespace {
+uint32_t crc32(const unsigned char *data, size_t n, uint32_t crc = 0) {
+  static uint32_t table[256] = {0};
+  if (table[1] == 0) {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      table[i] = c;
+    }
+  }
+  crc = ~crc;
+  for (size_t i = 0; i < n; i++) {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void putBigEndian(std::vector<unsigned char> &out, uint32_t v) {
+  out.push_back(v >> 24);
+  out.push_back((v >> 16) & 0xFF);
+  out.push_back((v >> 8) & 0xFF);
+  out.push_back(v & 0xFF);
+}
+
+void writeChunk(std::ofstream &w, const char *type,
+                const std::vector<unsigned char> &data) {
+  std::vector<unsigned char> head;
+  putBigEndian(head, data.size());
+  head.insert(head.end(), type, type + 4);
+  uint32_t crc = crc32(head.data() + 4, 4);
+  crc = crc32(data.data(), data.size(), crc);
+  std::vector<unsigned char> tail;
+  putBigEndian(tail, crc);
+  w.write((const char *)head.data(), head.size());
+  w.write((const char *)data.data(), data.size());
+  w.write((const char *)tail.data(), tail.size());
+}
+} // namespace
+
+// Constructors
+Renderer::Renderer(const std::vector<double> &xIn,
+                   const std::vector<double> &yIn,
+                   const std::vector<unsigned> &connIn, unsigned size)
+    : x(xIn), y(yIn), conn(connIn), bad(0), good(1), margin(4) {
+  if (x.size() == 0 || conn.size() == 0) {
+    throw std::invalid_argument("No mesh to render\n");
+  }
+  if (size <= 2 * margin) {
+    throw std::invalid_argument("Image size too small to render\n");
+  }
+  xMin = *std::min_element(x.begin(), x.end());
+  yMin = *std::min_element(y.begin(), y.end());
+  double dx = *std::max_element(x.begin(), x.end()) - xMin;
+  double dy = *std::max_element(y.begin(), y.end()) - yMin;
+  // Longest side spans the image, the other keeps the aspect ratio
+  scale = (size - 2 * margin) / std::max(dx, dy);
+  width = std::ceil(dx * scale) + 2 * margin;
+  height = std::ceil(dy * scale) + 2 * margin;
+  pixels.assign((size_t)3 * width * height, 255);
+}
+
+// Public methods
+unsigned Renderer::getWidth() const { return width; }
+
+unsigned Renderer::getHeight() const { return height; }
+
+void Renderer::shade(const std::vector<double> &values, double badValue,
+                     double goodValue) {
+  if (values.size() != conn.size() / 3) {
+    throw std::invalid_argument("Shade values do not match mesh\n");
+  }
+  value = values;
+  bad = badValue;
+  good = goodValue;
+}
+
+void Renderer::rasterize(bool edges) {
+  std::fill(pixels.begin(), pixels.end(), 255);
+  unsigned char color[3];
+  for (unsigned i = 0; i < conn.size() / 3; i++) {
+    elementColor(i, color);
+    fillTriangle(i, color);
+  }
+  if (!edges) {
+    return;
+  }
+  for (unsigned i = 0; i < conn.size() / 3; i++) {
+    double px[3], py[3];
+    for (int k = 0; k < 3; k++) {
+      toPixel(conn[3 * i + k], px[k], py[k]);
+    }
+    for (int k = 0; k < 3; k++) {
+      drawLine(px[k], py[k], px[(k + 1) % 3], py[(k + 1) % 3]);
+    }
+  }
+}
+
+bool Renderer::edgesVisible() const {
+  // Below a few pixels per element the outlines cover the fill entirely
+  double inside = (double)(width - 2 * margin) * (height - 2 * margin);
+  return inside / (conn.size() / 3) >= 16;
+}
+
+void Renderer::printPPM(const char *outFile) const {
+  std::ofstream w(outFile, std::ios::binary);
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", outFile);
+    exit(EXIT_FAILURE);
+  }
+  w << "P6\n" << width << " " << height << "\n255\n";
+  w.write((const char *)pixels.data(), pixels.size());
+  w.close();
+}
+
+void Renderer::printPNG(const char *outFile) const {
+  // Deflate "stored" blocks need no compressor, only the checksums
+  std::ofstream w(outFile, std::ios::binary);
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", outFile);
+    exit(EXIT_FAILURE);
+  }
+  const unsigned char signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+  w.write((const char *)signature, 8);
+  std::vector<unsigned char> header;
+  putBigEndian(header, width);
+  putBigEndian(header, height);
+  const unsigned char format[5] = {8, 2, 0, 0, 0}; // 8-bit RGB
+  header.insert(header.end(), format, format + 5);
+  writeChunk(w, "IHDR", header);
+  // Each row starts with filter type 0 (none)
+  size_t rowBytes = 3 * (size_t)width;
+  std::vector<unsigned char> raw;
+  raw.reserve((rowBytes + 1) * height);
+  for (unsigned r = 0; r < height; r++) {
+    raw.push_back(0);
+    raw.insert(raw.end(), pixels.begin() + r * rowBytes,
+               pixels.begin() + (r + 1) * rowBytes);
+  }
+  std::vector<unsigned char> data;
+  data.reserve(raw.size() + 5 * (raw.size() / 65535 + 1) + 6);
+  data.push_back(0x78);
+  data.push_back(0x01);
+  for (size_t start = 0; start < raw.size(); start += 65535) {
+    size_t n = std::min(raw.size() - start, (size_t)65535);
+    data.push_back(start + n == raw.size() ? 1 : 0);
+    data.push_back(n & 0xFF);
+    data.push_back(n >> 8);
+    data.push_back(~n & 0xFF);
+    data.push_back((~n >> 8) & 0xFF);
+    data.insert(data.end(), raw.begin() + start, raw.begin() + start + n);
+  }
+  uint32_t a = 1, b = 0;
+  for (size_t i = 0; i < raw.size(); i++) {
+    a = (a + raw[i]) % 65521;
+    b = (b + a) % 65521;
+  }
+  putBigEndian(data, (b << 16) | a);
+  writeChunk(w, "IDAT", data);
+  writeChunk(w, "IEND", std::vector<unsigned char>());
+  w.close();
+}
+
+void Renderer::printSVG(const char *outFile) const {
+  std::ofstream w(outFile);
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", outFile);
+    exit(EXIT_FAILURE);
+  }
+  w << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << width
+    << "\" height=\"" << height << "\" viewBox=\"0 0 " << width << " "
+    << height << "\">\n"
+    << "<g stroke=\"black\" stroke-width=\"0.5\">\n";
+  unsigned char color[3];
+  char hex[8];
+  for (unsigned i = 0; i < conn.size() / 3; i++) {
+    elementColor(i, color);
+    snprintf(hex, sizeof(hex), "#%02x%02x%02x", color[0], color[1],
+             color[2]);
+    w << "<polygon fill=\"" << hex << "\" points=\"";
+    for (int k = 0; k < 3; k++) {
+      double px, py;
+      toPixel(conn[3 * i + k], px, py);
+      w << px << "," << py << (k < 2 ? " " : "\"/>\n");
+    }
+  }
+  w << "</g>\n</svg>\n";
+  w.close();
+}
+
+// Protected methods
+void Renderer::toPixel(unsigned node, double &px, double &py) const {
+  // Image rows run downwards, mesh y upwards
+  px = margin + (x[node] - xMin) * scale;
+  py = height - margin - (y[node] - yMin) * scale;
+}
+
+void Renderer::elementColor(unsigned elem, unsigned char *color) const {
+  if (value.size() == 0) {
+    color[0] = color[1] = color[2] = 220;
+    return;
+  }
+  // Red through yellow to green as the value goes from bad to good
+  double t = good != bad ? (value[elem] - bad) / (good - bad) : 1;
+  t = std::max(0.0, std::min(t, 1.0));
+  color[0] = t < 0.5 ? 255 : (unsigned char)(255 * 2 * (1 - t));
+  color[1] = t < 0.5 ? (unsigned char)(255 * 2 * t) : 255;
+  color[2] = 0;
+}
+
+void Renderer::fillTriangle(unsigned elem, const unsigned char *color) {
+  // Fill the pixels whose centers lie inside, one row at a time
+  double px[3], py[3];
+  for (int k = 0; k < 3; k++) {
+    toPixel(conn[3 * elem + k], px[k], py[k]);
+  }
+  double top = std::min(py[0], std::min(py[1], py[2]));
+  double bottom = std::max(py[0], std::max(py[1], py[2]));
+  int rowBegin = std::max(0.0, std::ceil(top - 0.5));
+  int rowEnd = std::min((double)height - 1, std::floor(bottom - 0.5));
+  for (int r = rowBegin; r <= rowEnd; r++) {
+    double yc = r + 0.5;
+    double left = width, right = -1;
+    for (int k = 0; k < 3; k++) {
+      int l = (k + 1) % 3;
+      if (py[k] == py[l] || yc < std::min(py[k], py[l]) ||
+          yc > std::max(py[k], py[l])) {
+        continue;
+      }
+      double xc = px[k] + (yc - py[k]) * (px[l] - px[k]) / (py[l] - py[k]);
+      left = std::min(left, xc);
+      right = std::max(right, xc);
+    }
+    int colBegin = std::max(0.0, std::ceil(left - 0.5));
+    int colEnd = std::min((double)width - 1, std::floor(right - 0.5));
+    if (colBegin > colEnd) {
+      continue;
+    }
+    unsigned char *p = &pixels[3 * ((size_t)r * width + colBegin)];
+    for (int c = colBegin; c <= colEnd; c++, p += 3) {
+      p[0] = color[0];
+      p[1] = color[1];
+      p[2] = color[2];
+    }
+  }
+}
+
+void Renderer::drawLine(double x0, double y0, double x1, double y1) {
+  // Step one pixel at a time along the longer direction
+  int steps = std::ceil(std::max(std::fabs(x1 - x0), std::fabs(y1 - y0)));
+  steps = std::max(steps, 1);
+  for (int s = 0; s <= steps; s++) {
+    double t = (double)s / steps;
+    int c = std::floor(x0 + t * (x1 - x0));
+    int r = std::floor(y0 + t * (y1 - y0));
+    if (c < 0 || r < 0 || c >= (int)width || r >= (int)height) {
+      continue;
+    }
+    unsigned char *p = &pixels[3 * ((size_t)r * width + c)];
+    p[0] = p[1] = p[2] = 0;
+  }
+}
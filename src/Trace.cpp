@@ -0,0 +1,120 @@
+#include "../include/Trace.h"
+
+bool Trace::enabled = false;
+bool Trace::tracking = false;
+thread_local const char *Trace::phase = nullptr;
+std::chrono::steady_clock::time_point Trace::origin;
+std::mutex Trace::lock;
+std::vector<Trace::Event> Trace::events;
+std::map<std::thread::id, unsigned> Trace::threads;
+
+// Constructors
+Trace::Span::Span(const char *spanName, const char *spanCategory,
+                  const std::string &spanFile)
+    : name(spanName), category(spanCategory), parent(phase), start(0),
+      active(enabled) {
+  if (tracking) {
+    phase = name;
+  }
+  if (active) {
+    file = spanFile;
+    start = now();
+  }
+}
+
+// Destructor
+Trace::Span::~Span() {
+  if (tracking) {
+    phase = parent;
+  }
+  if (!active) {
+    return;
+  }
+  double end = now();
+  std::lock_guard<std::mutex> guard(lock);
+  Event e = {name, category, file, start, end - start, threadIndex()};
+  events.push_back(e);
+}
+
+// Public methods
+void Trace::enable() {
+  std::lock_guard<std::mutex> guard(lock);
+  events.clear();
+  threads.clear();
+  threadIndex(); // The enabling thread is the main row
+  origin = std::chrono::steady_clock::now();
+  enabled = true;
+  tracking = true;
+}
+
+bool Trace::isEnabled() { return enabled; }
+
+void Trace::trackPhases() { tracking = true; }
+
+const char *Trace::currentPhase() { return phase; }
+
+void Trace::write(const char *outFile) {
+  std::lock_guard<std::mutex> guard(lock);
+  std::ofstream w(outFile);
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", outFile);
+    exit(EXIT_FAILURE);
+  }
+  std::vector<std::string> lines;
+  // Name the threads so viewers show "main" and "worker n" rows
+  for (unsigned t = 0; t < threads.size(); t++) {
+    std::ostringstream s;
+    s << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+      << t << ", \"args\": {\"name\": \""
+      << (t == 0 ? "main" : "worker " + std::to_string(t)) << "\"}}";
+    lines.push_back(s.str());
+  }
+  for (unsigned i = 0; i < events.size(); i++) {
+    const Event &e = events[i];
+    std::ostringstream s;
+    s << std::fixed << std::setprecision(3) << "{\"name\": \""
+      << escape(e.name) << "\", \"cat\": \"" << escape(e.category)
+      << "\", \"ph\": \"X\", \"ts\": " << e.start << ", \"dur\": "
+      << e.duration << ", \"pid\": 1, \"tid\": " << e.thread;
+    if (!e.file.empty()) {
+      s << ", \"args\": {\"file\": \"" << escape(e.file) << "\"}";
+    }
+    s << "}";
+    lines.push_back(s.str());
+  }
+  w << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+  for (unsigned i = 0; i < lines.size(); i++) {
+    w << lines[i] << (i + 1 < lines.size() ? ",\n" : "\n");
+  }
+  w << "]}\n";
+  w.close();
+}
+
+// Protected methods
+double Trace::now() {
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - origin;
+  return elapsed.count();
+}
+
+unsigned Trace::threadIndex() {
+  std::map<std::thread::id, unsigned>::iterator it =
+      threads.find(std::this_thread::get_id());
+  if (it != threads.end()) {
+    return it->second;
+  }
+  unsigned index = threads.size();
+  threads[std::this_thread::get_id()] = index;
+  return index;
+}
+
+std::string Trace::escape(const std::string &text) {
+  std::string out;
+  for (unsigned i = 0; i < text.size(); i++) {
+    if (text[i] == '"' || text[i] == '\\') {
+      out += '\\';
+    }
+    out += text[i];
+  }
+  return out;
+}
@@ -1,18 +1,126 @@
 #include "../include/Triangulation.h"
 
+namespace {
+double smallestAngle(Node *a, Node *b, Node *c) {
+  // Smallest interior angle of triangle a, b, c in degrees
+  Node *v[3] = {a, b, c};
+  double best = 180;
+  for (int k = 0; k < 3; k++) {
+    Vec2d e1 = v[(k + 1) % 3]->getPoint() - v[k]->getPoint();
+    Vec2d e2 = v[(k + 2) % 3]->getPoint() - v[k]->getPoint();
+    double cosine = e1.dot(e2) / (e1.length() * e2.length());
+    best = std::min(best, acos(std::max(-1.0, std::min(cosine, 1.0))));
+  }
+  return best * 180 / M_PI;
+}
+
+double flipGain(Node *s0, Node *s1, Node *op1, Node *op2) {
+  // Rise in the smaller minimum angle of the pair if diagonal s0-s1 became
+  // op1-op2, computed from coordinates (nothing is built)
+  double before =
+      std::min(smallestAngle(s0, s1, op1), smallestAngle(s0, s1, op2));
+  double after =
+      std::min(smallestAngle(op1, op2, s0), smallestAngle(op1, op2, s1));
+  return after - before;
+}
+
+std::vector<Element *> outsideFirst(Element *a, Element *b, Element *inside) {
+  // Adjacent list of a flipped element: neighbors outside the pair by
+  // address, then the other element of the pair
+  std::vector<Element *> ans;
+  if (a != nullptr) {
+    ans.push_back(a);
+  }
+  if (b != nullptr) {
+    ans.push_back(b);
+  }
+  if (ans.size() == 2 && std::less<Element *>()(b, a)) {
+    std::swap(ans[0], ans[1]);
+  }
+  ans.push_back(inside);
+  return ans;
+}
+} // namespace
+
 // Constructors
 Triangulation::Triangulation(std::vector<Node *> &nodeGrid) {
   nodes = nodeGrid;
   triangulate();
   DelaunayFlag = false;
+  budgetFlag = false;
   randFlag = false;
 }
 
-Triangulation::Triangulation(const Triangulation &rhs) {
-  nodes = rhs.getNodes();
-  elements = rhs.getElem();
-  DelaunayFlag = rhs.isDelaunay();
-  randFlag = rhs.isRandom();
+Triangulation::Triangulation(std::vector<Node *> &nodeGrid,
+                             const std::vector<unsigned> &conn) {
+  // Rebuild an existing mesh: conn holds 3 indices into nodeGrid per
+  // element
+  nodes = nodeGrid;
+  DelaunayFlag = false;
+  budgetFlag = false;
+  randFlag = false;
+  if (EdgeTable(conn).numOverfullEdges() != 0) {
+    throw std::runtime_error("Mesh has edges shared by more than two "
+                             "elements.\n");
+  }
+  unsigned n = conn.size() / 3;
+  elements.reserve(n);
+  for (unsigned i = 0; i < n; i++) {
+    Node *a = nodes[conn[3 * i]];
+    Node *b = nodes[conn[3 * i + 1]];
+    Node *c = nodes[conn[3 * i + 2]];
+    if (a == b || b == c || c == a) {
+      throw std::runtime_error("Element repeats a node.\n");
+    }
+    a->connect(b);
+    b->connect(c);
+    c->connect(a);
+    std::vector<Node *> v = {a, b, c};
+    elements.push_back(new Element(v));
+  }
+  initAdjacents();
+}
+
+Triangulation::Triangulation(const Triangulation &rhs)
+    : Triangulation(rhs, rhs.nodes) {}
+
+Triangulation::Triangulation(const Triangulation &rhs,
+                             const std::vector<Node *> &nodeGrid) {
+  // Elements are rebuilt rather than shared, so each triangulation deletes
+  // only its own. nodeGrid[i] stands in for rhs.nodes[i]; new nodes get
+  // connected by the same edges.
+  if (nodeGrid.size() != rhs.nodes.size()) {
+    throw std::invalid_argument("Copy needs one node per node in the "
+                                "triangulation\n");
+  }
+  nodes = nodeGrid;
+  DelaunayFlag = rhs.DelaunayFlag;
+  budgetFlag = rhs.budgetFlag;
+  randFlag = rhs.randFlag;
+  flips = rhs.flips;
+  std::unordered_map<const Node *, Node *> match;
+  for (unsigned i = 0; i < nodes.size(); i++) {
+    match[rhs.nodes[i]] = nodes[i];
+  }
+  elements.reserve(rhs.elements.size());
+  for (unsigned j = 0; j < rhs.elements.size(); j++) {
+    const Element &old = *rhs.elements[j];
+    std::vector<Node *> v = {match[old[0]], match[old[1]], match[old[2]]};
+    v[0]->connect(v[1]);
+    v[1]->connect(v[2]);
+    v[2]->connect(v[0]);
+    elements.push_back(new Element(v));
+    elements.back()->setID(old.getID());
+  }
+  initAdjacents();
+}
+
+Triangulation::Triangulation(Triangulation &&rhs)
+    : nodes(std::move(rhs.nodes)), elements(std::move(rhs.elements)),
+      DelaunayFlag(rhs.DelaunayFlag), budgetFlag(rhs.budgetFlag),
+      randFlag(rhs.randFlag), flips(rhs.flips) {
+  rhs.nodes.clear();
+  rhs.elements.clear();
 }
 
 // Destructor
@@ -26,23 +134,30 @@ Triangulation::~Triangulation() {
 Triangulation &Triangulation::operator=(const Triangulation &rhs) {
   if (&rhs != this) {
     Triangulation temp = rhs;
-    std::vector<Node *> n = nodes;
-    std::vector<Element *> e = elements;
-    bool d = DelaunayFlag;
-    nodes = temp.nodes;
-    elements = temp.elements;
-    DelaunayFlag = temp.DelaunayFlag;
-    temp.nodes = n;
-    temp.elements = e;
-    temp.DelaunayFlag = d;
+    *this = std::move(temp);
+  }
+  return *this;
+}
+
+Triangulation &Triangulation::operator=(Triangulation &&rhs) {
+  // The old elements go with rhs, which is about to be destroyed
+  if (&rhs != this) {
+    std::swap(nodes, rhs.nodes);
+    std::swap(elements, rhs.elements);
+    std::swap(DelaunayFlag, rhs.DelaunayFlag);
+    std::swap(budgetFlag, rhs.budgetFlag);
+    std::swap(randFlag, rhs.randFlag);
+    std::swap(flips, rhs.flips);
   }
   return *this;
 }
 
 // Public methods
-std::vector<Node *> Triangulation::getNodes() const { return nodes; }
+const std::vector<Node *> &Triangulation::getNodes() const { return nodes; }
 
-std::vector<Element *> Triangulation::getElem() const { return elements; }
+const std::vector<Element *> &Triangulation::getElem() const {
+  return elements;
+}
 
 void Triangulation::printMesh() {
   std::cout << "$nodes" << std::endl;
@@ -56,15 +171,7 @@ void Triangulation::printMesh() {
 }
 
 void Triangulation::printMesh(const char *outFile) {
-  std::string root = outFile;
-  if (randFlag) {
-    root = root + ".rnd";
-  }
-  if (DelaunayFlag) {
-    root = root + ".del.msh";
-  } else {
-    root = root + ".msh";
-  }
+  std::string root = fileRoot(outFile) + ".msh";
   std::ofstream w(root.c_str());
   if (!(w.is_open())) {
     fprintf(stderr, "Error opening %s", root.c_str());
@@ -89,71 +196,475 @@ void Triangulation::printMesh(const char *outFile) {
   w.close();
 }
 
+void Triangulation::moveNode(unsigned index, double x, double y,
+                             GeometryCache *cache) {
+  // The caller keeps the elements unfolded; Delaunay() afterwards restores
+  // the empty circle property the move may have broken. A cache built from
+  // getArrays() has its elements around the node marked for update().
+  if (index >= nodes.size()) {
+    throw std::invalid_argument("Index out of bounds in triangulation\n");
+  }
+  nodes[index]->moveTo(x, y);
+  if (cache != nullptr) {
+    cache->moveNode(index, x, y);
+  }
+  DelaunayFlag = false;
+  budgetFlag = false;
+}
+
 void Triangulation::Delaunay() {
+  // Lawson flips from a stack of elements whose edges may be illegal: all
+  // of them at first, then both elements of each flip, as only the four
+  // outer edges of the flipped quad can have turned illegal. Each element
+  // is tested again only when a flip changes it, instead of once per sweep
+  // until a sweep flips nothing.
+  std::vector<Element *> stack(elements.rbegin(), elements.rend());
+  std::vector<std::vector<Node *>> newElem;
+  while (!stack.empty()) {
+    Element *ele = stack.back();
+    stack.pop_back();
+    const std::vector<Element *> &adj = ele->getAdjacent();
+    for (unsigned j = 0; j < adj.size(); j++) {
+      Node *s0, *s1, *op1, *op2;
+      FlipStatus status;
+      flips.tested++;
+      try {
+        status = checkFlip(adj[j], ele, s0, s1, op1, op2);
+      } catch (...) {
+        // Only a broken mesh gets here, so count it and pass it on
+        flips.thrown++;
+        throw;
+      }
+      if (status != FLIPPABLE) {
+        flips.rejected++;
+        continue;
+      }
+      if (isLegal(s0, s1, op1, op2)) {
+        continue;
+      }
+      // The flip rewrites adj, so stop reading it
+      Element *other = adj[j];
+      flips.flipped++;
+      op1->connect(op2);
+      newElem = {{op1, op2, s0}, {op1, op2, s1}};
+      applyFlip(ele, other, newElem);
+      stack.push_back(other);
+      stack.push_back(ele);
+      break;
+    }
+  }
+  DelaunayFlag = true;
+  budgetFlag = false;
+}
+
+void Triangulation::DelaunayMinAngle() {
+  // The original rule, kept as the reference the differential harness
+  // checks Delaunay() against: flip when the pair's minimum angle rises,
+  // compared in floating point, so cocircular ties fall to rounding
   bool keepRunningFlag;
   do {
     keepRunningFlag = false;
     for (unsigned i = 0; i < elements.size(); i++) {
-      std::vector<Element *> adj = elements[i]->getAdjacent();
+      // A flip rewrites this list, but the loop breaks right after one
+      const std::vector<Element *> &adj = elements[i]->getAdjacent();
       for (unsigned j = 0; j < adj.size(); j++) {
         double minInt = minimumInteriorAngle(elements[i], adj[j]);
         // If the new min interior angle is greater than the prev one, make
         // hypothetical elements the real ones
         std::vector<std::vector<Node *>> newElem;
+        FlipStatus status;
+        flips.tested++;
         try {
-          newElem = tryDelaunay(adj[j], elements[i]);
-          Element *hyp1 = new Element(newElem[0]);
-          Element *hyp2 = new Element(newElem[1]);
-          if ((minInt < minimumInteriorAngle(hyp1, hyp2))) {
-            std::vector<Element *> oldElems = {adj[j], elements[i]};
-            std::vector<Element *> thePool = elements[i]->getFringe(oldElems);
-            for (unsigned m = 0; m < thePool.size(); m++) {
-              if (thePool[m] == adj[j] || thePool[m] == elements[i]) {
-                thePool.erase(thePool.begin() + m);
-              }
-            }
-            keepRunningFlag = true;
-            elements[i]->redefine(newElem[0]);
-            adj[j]->redefine(newElem[1]);
-            std::vector<Element *> updatedElem = {adj[j], elements[i]};
-            elements[i]->fixAdjacency(updatedElem, thePool);
-            delete hyp1;
-            delete hyp2;
-            break;
-          } else {
-            delete hyp1;
-            delete hyp2;
-          }
+          status = tryDelaunay(adj[j], elements[i], newElem);
         } catch (...) {
+          // Only a broken mesh gets here, so count it and pass it on
+          flips.thrown++;
+          throw;
+        }
+        if (status != FLIPPABLE) {
+          flips.rejected++;
           continue;
         }
+        Element *hyp1 = new Element(newElem[0]);
+        Element *hyp2 = new Element(newElem[1]);
+        if ((minInt < minimumInteriorAngle(hyp1, hyp2))) {
+          keepRunningFlag = true;
+          flips.flipped++;
+          applyFlip(elements[i], adj[j], newElem);
+          delete hyp1;
+          delete hyp2;
+          break;
+        } else {
+          delete hyp1;
+          delete hyp2;
+        }
       }
     }
   } while (keepRunningFlag);
   DelaunayFlag = true;
+  budgetFlag = false;
+}
+
+Triangulation::StopReason
+Triangulation::DelaunayPriority(const FlipBudget &budget) {
+  // Same flips as Delaunay(), taken largest min-angle gain first from a
+  // max-heap. Both flip exactly the edges isLegal() rejects, so converged
+  // runs end on the same mesh. Every flip leaves a valid mesh, so the
+  // budget can stop the run after any of them; only a run that empties
+  // the heap is converged.
+  struct Candidate {
+    double gain;
+    Element *ele, *adj;
+    unsigned eleVersion, adjVersion; // Stale once either element flips
+    bool operator<(const Candidate &rhs) const { return gain < rhs.gain; }
+  };
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  std::unordered_map<Element *, unsigned> version;
+  std::unordered_map<Element *, double> angle; // Smallest, in degrees
+  std::multiset<double> angles;
+  std::priority_queue<Candidate> heap;
+  std::vector<std::vector<Node *>> newElem;
+  auto smallest = [](Element *e) {
+    return smallestAngle((*e)[0], (*e)[1], (*e)[2]);
+  };
+  auto stale = [&](const Candidate &c) {
+    return c.eleVersion != version[c.ele] || c.adjVersion != version[c.adj];
+  };
+  auto offer = [&](Element *e) {
+    const std::vector<Element *> &adj = e->getAdjacent();
+    for (unsigned j = 0; j < adj.size(); j++) {
+      Node *s0, *s1, *op1, *op2;
+      flips.tested++;
+      if (checkFlip(adj[j], e, s0, s1, op1, op2) != FLIPPABLE) {
+        flips.rejected++;
+      } else if (!isLegal(s0, s1, op1, op2)) {
+        // Cocircular quads are flipped by the perturbation at no gain
+        Candidate c = {flipGain(s0, s1, op1, op2), e, adj[j], version[e],
+                       version[adj[j]]};
+        heap.push(c);
+      }
+    }
+  };
+  for (unsigned i = 0; i < elements.size(); i++) {
+    version[elements[i]] = 0;
+    angle[elements[i]] = smallest(elements[i]);
+    angles.insert(angle[elements[i]]);
+  }
+  for (unsigned i = 0; i < elements.size(); i++) {
+    offer(elements[i]);
+  }
+  StopReason reason = CONVERGED;
+  unsigned flipped = 0;
+  while (!heap.empty()) {
+    if (budget.minAngle > 0 && *angles.begin() >= budget.minAngle) {
+      reason = REACHED_ANGLE;
+      break;
+    }
+    if (budget.flips > 0 && flipped >= budget.flips) {
+      reason = OUT_OF_FLIPS;
+      break;
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (budget.seconds > 0 && elapsed.count() >= budget.seconds) {
+      reason = OUT_OF_TIME;
+      break;
+    }
+    Candidate c = heap.top();
+    heap.pop();
+    if (stale(c)) {
+      continue;
+    }
+    // Still current, so still convex and still illegal
+    Node *s0, *s1, *op1, *op2;
+    checkFlip(c.adj, c.ele, s0, s1, op1, op2);
+    newElem = {{op1, op2, s0}, {op1, op2, s1}};
+    op1->connect(op2);
+    applyFlip(c.ele, c.adj, newElem);
+    flips.flipped++;
+    flipped++;
+    Element *changed[2] = {c.ele, c.adj};
+    for (int k = 0; k < 2; k++) {
+      version[changed[k]]++;
+      angles.erase(angles.find(angle[changed[k]]));
+      angle[changed[k]] = smallest(changed[k]);
+      angles.insert(angle[changed[k]]);
+    }
+    offer(c.ele);
+    offer(c.adj);
+  }
+  // Only a current entry is an edge still failing the incircle test; if a
+  // budget stopped the run with none left, it had converged after all
+  while (!heap.empty() && stale(heap.top())) {
+    heap.pop();
+  }
+  if (heap.empty()) {
+    reason = budget.minAngle > 0 && *angles.begin() >= budget.minAngle
+                 ? REACHED_ANGLE
+                 : CONVERGED;
+  }
+  DelaunayFlag = heap.empty();
+  budgetFlag = !heap.empty();
+  return reason;
+}
+
+void Triangulation::printBinary(const char *outFile,
+                                const GeometryCache *cache) {
+  // Layout: "DMSH", then uint32 version, node count, element count and
+  // flags (1 if a geometry cache follows), the node x and y arrays as
+  // doubles, 0-based uint32 connectivity, then the cache arrays if any
+  std::string root = fileRoot(outFile) + ".bin";
+  std::ofstream w(root.c_str(), std::ios::binary);
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", root.c_str());
+    exit(EXIT_FAILURE);
+  }
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  getArrays(x, y, conn);
+  std::vector<uint32_t> connOut(conn.begin(), conn.end());
+  uint32_t header[4] = {1, (uint32_t)x.size(), (uint32_t)(conn.size() / 3),
+                        cache != nullptr ? 1u : 0u};
+  w.write("DMSH", 4);
+  w.write((const char *)header, sizeof(header));
+  w.write((const char *)x.data(), x.size() * sizeof(double));
+  w.write((const char *)y.data(), y.size() * sizeof(double));
+  w.write((const char *)connOut.data(), connOut.size() * sizeof(uint32_t));
+  if (cache != nullptr) {
+    if (cache->size() != elements.size()) {
+      throw std::invalid_argument("Geometry cache does not match mesh\n");
+    }
+    cache->write(w);
+  }
+  w.close();
+}
+
+std::string Triangulation::fileRoot(const char *inFile) const {
+  std::string root = inFile;
+  if (randFlag) {
+    root = root + ".rnd";
+  }
+  if (DelaunayFlag) {
+    root = root + ".del";
+  }
+  if (budgetFlag) {
+    root = root + ".budget"; // Flips stopped early, not Delaunay
+  }
+  return root;
+}
+
+void Triangulation::getArrays(std::vector<double> &x, std::vector<double> &y,
+                              std::vector<unsigned> &conn) const {
+  // Flatten the pointer structure into coordinate arrays and 0-based
+  // connectivity indices into them (in the order nodes are stored)
+  // IDs are usually 1 to n, looked up in a table of n + 1; loaded meshes
+  // may number their nodes sparsely, and then go through a hash map
+  unsigned maxID = 0;
+  for (unsigned i = 0; i < nodes.size(); i++) {
+    maxID = std::max(maxID, nodes[i]->getID());
+  }
+  bool dense = maxID <= nodes.size();
+  std::vector<unsigned> table(dense ? nodes.size() + 1 : 0, 0);
+  std::unordered_map<unsigned, unsigned> sparse;
+  x.resize(nodes.size());
+  y.resize(nodes.size());
+  for (unsigned i = 0; i < nodes.size(); i++) {
+    if (dense) {
+      table[nodes[i]->getID()] = i;
+    } else {
+      sparse[nodes[i]->getID()] = i;
+    }
+    x[i] = (*nodes[i])[0];
+    y[i] = (*nodes[i])[1];
+  }
+  conn.resize(3 * elements.size());
+  for (unsigned j = 0; j < elements.size(); j++) {
+    for (int k = 0; k < 3; k++) {
+      unsigned id = (*elements[j])[k]->getID();
+      conn[3 * j + k] = dense ? table[id] : sparse[id];
+    }
+  }
+}
+
+void Triangulation::renumberNodes(const std::vector<unsigned> &order) {
+  // order[k] is the current index of the node that becomes number k + 1.
+  // Elements print their vertices by ID, so connectivity follows along.
+  if (order.size() != nodes.size()) {
+    throw std::invalid_argument("Node ordering does not cover every node\n");
+  }
+  std::vector<Node *> reordered(nodes.size());
+  for (unsigned k = 0; k < order.size(); k++) {
+    reordered[k] = nodes[order[k]];
+    reordered[k]->setID(k + 1);
+  }
+  nodes = reordered;
+}
+
+void Triangulation::renumberElements(const std::vector<unsigned> &order) {
+  // order[k] is the current index of the element that becomes number k + 1
+  if (order.size() != elements.size()) {
+    throw std::invalid_argument(
+        "Element ordering does not cover every element\n");
+  }
+  std::vector<Element *> reordered(elements.size());
+  for (unsigned k = 0; k < order.size(); k++) {
+    reordered[k] = elements[order[k]];
+    reordered[k]->setID(k + 1);
+  }
+  elements = reordered;
+}
+
+Coloring Triangulation::color(Coloring::Method method,
+                              unsigned threads) const {
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  getArrays(x, y, conn);
+  return Coloring(conn, nodes.size(), method, threads);
 }
 
 bool Triangulation::isDelaunay() const { return DelaunayFlag; }
 
+const Triangulation::FlipStats &Triangulation::getFlipStats() const {
+  return flips;
+}
+
+std::size_t Triangulation::memoryBytes() const {
+  std::size_t total = sizeof(Triangulation) +
+                      nodes.capacity() * sizeof(Node *) +
+                      elements.capacity() * sizeof(Element *);
+  for (unsigned i = 0; i < nodes.size(); i++) {
+    total += nodes[i]->memoryBytes();
+  }
+  for (unsigned j = 0; j < elements.size(); j++) {
+    total += elements[j]->memoryBytes();
+  }
+  return total;
+}
+
+std::string Triangulation::flipSummary() const {
+  std::ostringstream s;
+  s << flips.tested << " flips tested, " << flips.rejected
+    << " rejected, " << flips.flipped << " flipped, " << flips.thrown
+    << " exceptions";
+  return s.str();
+}
+
+uint64_t Triangulation::canonicalHash() const {
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  getArrays(x, y, conn);
+  return canonicalHash(x, y, conn);
+}
+
+uint64_t Triangulation::canonicalHash(const std::vector<double> &x,
+                                      const std::vector<double> &y,
+                                      const std::vector<unsigned> &conn) {
+  // Each element becomes its vertex coordinates in sorted order, the
+  // elements are sorted, and the coordinate bits hashed (64-bit FNV-1a).
+  // Numbering, element order and vertex rotation do not change the result.
+  std::vector<std::array<double, 6>> tris(conn.size() / 3);
+  for (unsigned j = 0; j < tris.size(); j++) {
+    std::array<std::pair<double, double>, 3> v;
+    for (int k = 0; k < 3; k++) {
+      unsigned n = conn[3 * j + k];
+      v[k] = std::make_pair(x[n] + 0.0, y[n] + 0.0); // -0 becomes 0
+    }
+    std::sort(v.begin(), v.end());
+    for (int k = 0; k < 3; k++) {
+      tris[j][2 * k] = v[k].first;
+      tris[j][2 * k + 1] = v[k].second;
+    }
+  }
+  std::sort(tris.begin(), tris.end());
+  uint64_t hash = 14695981039346656037ull;
+  for (unsigned j = 0; j < tris.size(); j++) {
+    const unsigned char *bytes = (const unsigned char *)tris[j].data();
+    for (unsigned b = 0; b < 6 * sizeof(double); b++) {
+      hash = (hash ^ bytes[b]) * 1099511628211ull;
+    }
+  }
+  return hash;
+}
+
 void Triangulation::setRandFlag(bool what) { randFlag = what; }
 
 bool Triangulation::isRandom() const { return randFlag; }
 
 // Protected methods
-void Triangulation::push(Node *newNode) {
+void Triangulation::push(Node *newNode, FanIndex &fans) {
+  // A node on an existing node, or outside the mesh, is left out
   if (elements.size() == 0) {
     throw std::invalid_argument("No elements created. Cannot push node.\n");
   }
-  for (unsigned i = 0; i < elements.size(); i++) {
-    if (elements[i]->nodeIsOnEdge(newNode) ||
-        elements[i]->containsNode(newNode)) {
-      std::vector<Element *> newElem = elements[i]->split(newNode);
-      for (unsigned j = 0; j < newElem.size(); j++) {
-        elements.push_back(newElem[j]);
+  Element *host = locate(newNode, fans);
+  if (host != nullptr) {
+    std::vector<Element *> newElem = host->split(newNode);
+    fans.update(host);
+    for (unsigned j = 0; j < newElem.size(); j++) {
+      fans.update(newElem[j]);
+      elements.push_back(newElem[j]);
+    }
+    const std::vector<Element *> &adj = host->getAdjacent();
+    for (unsigned m = 0; m < adj.size(); m++) {
+      // Split at an edge, the element across it was reshaped too
+      if (adj[m]->isVertex(newNode) &&
+          std::find(newElem.begin(), newElem.end(), adj[m]) == newElem.end()) {
+        fans.update(adj[m]);
       }
+    }
+  }
+}
+
+Element *Triangulation::locate(Node *newNode, const FanIndex &fans) {
+  // Walk from the newest element, which is next to the last node pushed,
+  // across any edge the node lies beyond. Rotating the edge tested first
+  // keeps the walk from circling in a non-Delaunay mesh. Past an edge of an
+  // indexed fan the walk jumps to the fan's element toward the node.
+  Element *current = elements.back();
+  unsigned step = 0;
+  for (; step < elements.size(); step++) {
+    Element *next = nullptr;
+    for (int i = 0; i < 3 && next == nullptr; i++) {
+      int k = (i + step) % 3;
+      if (current->sideOf(newNode, k) < 0) {
+        next = fans.sector((*current)[k], newNode);
+        if (next == nullptr) {
+          next = fans.sector((*current)[(k + 1) % 3], newNode);
+        }
+        if (next == nullptr) {
+          next = current->acrossEdge(k);
+        }
+        if (next == nullptr) {
+          return nullptr; // Outside the mesh
+        }
+      }
+    }
+    if (next == nullptr) {
       break;
     }
+    current = next;
+  }
+  if (step == elements.size()) {
+    throw std::runtime_error("Walk to the element holding a node did not "
+                             "end.\n");
   }
+  if (!(current->nodeIsOnEdge(newNode) || current->containsNode(newNode))) {
+    return nullptr;
+  }
+  // A node on an edge is held by both elements there. Pick the one that
+  // comes first in the element list (lowest ID, as elements are only
+  // appended here), as a scan of the whole list would.
+  Element *host = current;
+  for (int k = 0; k < 3; k++) {
+    Element *other = current->acrossEdge(k);
+    if (other != nullptr &&
+        newNode->isOnEdge((*current)[k], (*current)[(k + 1) % 3]) &&
+        other->getID() < host->getID()) {
+      host = other;
+    }
+  }
+  return host;
 }
 
 void Triangulation::buildOutsideEdges() {
@@ -164,7 +675,8 @@ void Triangulation::buildOutsideEdges() {
 }
 
 void Triangulation::addFirstNode() {
-  // First node will always be on the edges coming from nodes[0]
+  // First node will always be on the edges coming from nodes[0]. Copied:
+  // splitting connects more edges to nodes[0] while this is walked
   std::vector<Edge *> toCheck = nodes[0]->sourceNode();
   for (unsigned i = 0; i < toCheck.size(); i++) {
     if (toCheck[i]->crossesNode(nodes[4])) {
@@ -200,60 +712,131 @@ void Triangulation::triangulate() {
     initAdjacents();
   } else {
     addFirstNode();
+    unsigned first = 5;
+    if (elements.size() == 0) {
+      // Node 4 is not on the bottom or left side (points not from
+      // createGrid), so start from the diagonal and push it like the rest
+      buildDiagonal();
+      first = 4;
+    }
     initAdjacents();
-    for (unsigned i = 5; i < nodes.size(); i++) {
-      push(nodes[i]);
+    FanIndex fans;
+    for (unsigned i = first; i < nodes.size(); i++) {
+      push(nodes[i], fans);
     }
   }
 }
 
 void Triangulation::initAdjacents() {
+  // Elements across each edge come from an edge table in O(n), listed in
+  // element order
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  getArrays(x, y, conn);
+  EdgeTable table(conn);
   for (unsigned i = 0; i < elements.size(); i++) {
-    std::vector<Element *> ans;
-    for (unsigned j = 0; j < elements.size(); j++) {
-      if (elements[i] != elements[j] && elements[i]->shareEdge(elements[j])) {
-        ans.push_back(elements[j]);
+    std::vector<int> across;
+    for (int k = 0; k < 3; k++) {
+      if (table.neighbor(i, k) != -1) {
+        across.push_back(table.neighbor(i, k));
       }
     }
+    sort(across.begin(), across.end());
+    std::vector<Element *> ans;
+    for (unsigned k = 0; k < across.size(); k++) {
+      ans.push_back(elements[across[k]]);
+    }
     elements[i]->setAdjacent(ans);
   }
 }
 
 double Triangulation::minimumInteriorAngle(Element *el1, Element *el2) {
-  std::vector<double> angles;
+  double smallest = INFINITY;
   for (int i = 0; i < 3; i++) {
-    std::vector<Edge *> e1 = el1->sourceNode(i);
-    std::vector<Edge *> e2 = el2->sourceNode(i);
-    double angle1 = *(e1[0]) > e1[1];
-    double angle2 = *(e2[0]) > e2[1];
-    angles.push_back(std::min(angle1, angle2));
+    std::pair<Edge *, Edge *> e1 = el1->sourceNode(i);
+    std::pair<Edge *, Edge *> e2 = el2->sourceNode(i);
+    double angle1 = *(e1.first) > e1.second;
+    double angle2 = *(e2.first) > e2.second;
+    smallest = std::min(smallest, std::min(angle1, angle2));
   }
-  return *std::min_element(angles.begin(), angles.end());
+  return smallest;
 }
 
-std::vector<std::vector<Node *>> Triangulation::tryDelaunay(Element *adj,
-                                                            Element *ele) {
-  std::vector<Node *> sharedNodes = ele->findSharedNodes(adj);
-  Node *op1 = ele->findOppositeNode(sharedNodes[0], sharedNodes[1]);
-  Node *op2 = adj->findOppositeNode(sharedNodes[0], sharedNodes[1]);
-  // Do a hypothetical swap of the edges
-  Edge *hypE = new Edge(op1, op2);
-  Edge *basis1 = new Edge(op1, sharedNodes[0]);
-  Edge *basis2 = new Edge(op1, sharedNodes[1]);
-  std::vector<double> hypECoords = ele->findCoordinates(hypE, basis1, basis2);
-  delete basis1;
-  delete basis2;
-  if (ele->overlaps(hypE) || adj->overlaps(hypE) || hypECoords[0] < 0 ||
-      hypECoords[1] < 0) {
-    delete hypE;
-    throw overlappingEdge();
-  }
-  delete hypE;
+Triangulation::FlipStatus
+Triangulation::tryDelaunay(Element *adj, Element *ele,
+                           std::vector<std::vector<Node *>> &ans) {
+  Node *s0, *s1, *op1, *op2;
+  FlipStatus status = checkFlip(adj, ele, s0, s1, op1, op2);
+  if (status != FLIPPABLE) {
+    return status;
+  }
   op1->connect(op2);
-  std::vector<Node *> el1 = {op1, op2, sharedNodes[0]};
-  std::vector<Node *> el2 = {op1, op2, sharedNodes[1]};
-  std::vector<std::vector<Node *>> ans = {el1, el2};
-  return ans;
+  std::vector<Node *> el1 = {op1, op2, s0};
+  std::vector<Node *> el2 = {op1, op2, s1};
+  ans = {el1, el2};
+  return FLIPPABLE;
+}
+
+Triangulation::FlipStatus Triangulation::checkFlip(Element *adj, Element *ele,
+                                                   Node *&s0, Node *&s1,
+                                                   Node *&op1, Node *&op2) {
+  // Shared nodes s0, s1 and the opposite nodes of ele (op1) and adj (op2)
+  std::vector<Node *> sharedNodes = ele->findSharedNodes(adj);
+  if (sharedNodes.size() != 2) {
+    throw std::runtime_error("Adjacent elements do not share an edge.\n");
+  }
+  s0 = sharedNodes[0];
+  s1 = sharedNodes[1];
+  op1 = ele->findOppositeNode(s0, s1);
+  op2 = adj->findOppositeNode(s0, s1);
+  // The diagonal can only be swapped if the quad op1, s0, op2, s1 is
+  // strictly convex: each diagonal separates the ends of the other one
+  const Point2d &p0 = s0->getPoint(), &p1 = s1->getPoint();
+  const Point2d &q1 = op1->getPoint(), &q2 = op2->getPoint();
+  double side1 = orient2d(p0, p1, q1);
+  double side2 = orient2d(p0, p1, q2);
+  double side3 = orient2d(q1, q2, p0);
+  double side4 = orient2d(q1, q2, p1);
+  if (side1 == 0 || side2 == 0 || side3 == 0 || side4 == 0) {
+    return COLLINEAR;
+  }
+  if ((side1 > 0) == (side2 > 0) || (side3 > 0) == (side4 > 0)) {
+    return NOT_CONVEX;
+  }
+  return FLIPPABLE;
+}
+
+bool Triangulation::isLegal(Node *s0, Node *s1, Node *op1, Node *op2) const {
+  // Shared edge s0-s1 of the strictly convex quad op1, s0, op2, s1 stays
+  // unless op2 is inside the circle through s0, s1, op1, by the exact
+  // test CompactMesh uses too; ties are broken by node coordinates and ID
+  const Point2d pts[4] = {s0->getPoint(), s1->getPoint(), op1->getPoint(),
+                          op2->getPoint()};
+  const unsigned ids[4] = {s0->getID(), s1->getID(), op1->getID(),
+                           op2->getID()};
+  return isLocallyDelaunay(pts, ids);
+}
+
+void Triangulation::applyFlip(Element *ele, Element *adj,
+                              std::vector<std::vector<Node *>> &newElem) {
+  // ele takes newElem[0], adj newElem[1]; their neighbors are rewired edge
+  // by edge. Each keeps the two outside it in address order, then the other.
+  Node *op1 = newElem[0][0], *op2 = newElem[0][1];
+  Node *s0 = newElem[0][2], *s1 = newElem[1][2];
+  Element *eleOut0 = ele->across(s0, op1), *eleOut1 = ele->across(s1, op1);
+  Element *adjOut0 = adj->across(s0, op2), *adjOut1 = adj->across(s1, op2);
+  ele->redefine(newElem[0]);
+  adj->redefine(newElem[1]);
+  std::vector<Element *> eleAdj = outsideFirst(eleOut0, adjOut0, adj);
+  std::vector<Element *> adjAdj = outsideFirst(eleOut1, adjOut1, ele);
+  ele->setAdjacent(eleAdj);
+  adj->setAdjacent(adjAdj);
+  if (eleOut1 != nullptr) {
+    eleOut1->replaceAdjacent(ele, adj);
+  }
+  if (adjOut0 != nullptr) {
+    adjOut0->replaceAdjacent(adj, ele);
+  }
 }
 
 void Triangulation::buildDiagonal() {
@@ -0,0 +1,192 @@
+#include "../include/Validator.h"
+
+// Constructors
+Validator::Validator(const Triangulation &T, unsigned threads) {
+  numThreads = std::max(threads, 1u);
+  malformed = 0;
+  std::vector<double> x, y;
+  std::vector<unsigned> conn;
+  T.getArrays(x, y, conn);
+  EdgeTable table(conn);
+  check(x, y, conn, table);
+  // The adjacency the Elements carry must match the one derived from edges
+  const std::vector<Element *> &elements = T.getElem();
+  std::unordered_map<Element *, int> position;
+  for (unsigned i = 0; i < elements.size(); i++) {
+    position[elements[i]] = i;
+  }
+  for (unsigned i = 0; i < elements.size(); i++) {
+    const std::vector<Element *> &adj = elements[i]->getAdjacent();
+    std::vector<int> found, expected;
+    for (unsigned j = 0; j < adj.size(); j++) {
+      std::unordered_map<Element *, int>::iterator it = position.find(adj[j]);
+      found.push_back(it == position.end() ? -2 : it->second);
+    }
+    for (int k = 0; k < 3; k++) {
+      if (table.neighbor(i, k) != -1) {
+        expected.push_back(table.neighbor(i, k));
+      }
+    }
+    sort(found.begin(), found.end());
+    sort(expected.begin(), expected.end());
+    if (found != expected) {
+      badAdjacency++;
+    }
+  }
+}
+
+Validator::Validator(const std::vector<double> &x,
+                     const std::vector<double> &y,
+                     const std::vector<unsigned> &conn, unsigned threads) {
+  numThreads = std::max(threads, 1u);
+  if (x.size() != y.size()) {
+    throw std::invalid_argument("Point x and y arrays differ in length\n");
+  }
+  // The arrays may come from any engine, so an element with a node out of
+  // range or repeated is counted as degenerate and left out of the checks
+  std::vector<unsigned> sound;
+  malformed = keepSound(conn, x.size(), sound);
+  EdgeTable table(sound);
+  check(x, y, sound, table);
+  numElements += malformed;
+  degenerate += malformed;
+}
+
+// Public methods
+int Validator::eulerCharacteristic() const {
+  return (int)numNodes - (int)numEdges + (int)numElements;
+}
+
+unsigned Validator::numMalformed() const { return malformed; }
+
+bool Validator::isValid() const {
+  return degenerate == 0 && folded == 0 && overfull == 0 &&
+         badAdjacency == 0 && eulerCharacteristic() == 1;
+}
+
+bool Validator::isDelaunay() const { return nonDelaunay == 0; }
+
+std::string Validator::summary() const {
+  std::ostringstream s;
+  s << (isValid() && isDelaunay() ? "valid" : "INVALID") << ", "
+    << numElements << " elements, " << numEdges << " edges, " << numNodes
+    << " nodes, Euler characteristic " << eulerCharacteristic() << ", "
+    << degenerate << " degenerate, " << folded << " folded, " << overfull
+    << " non-manifold, " << badAdjacency << " bad adjacency, " << nonDelaunay
+    << " non-Delaunay";
+  return s.str();
+}
+
+// Protected methods
+unsigned Validator::keepSound(const std::vector<unsigned> &conn,
+                              std::size_t numPoints,
+                              std::vector<unsigned> &sound) {
+  unsigned malformed = 0;
+  sound.clear();
+  sound.reserve(conn.size());
+  for (unsigned i = 0; i + 2 < conn.size(); i += 3) {
+    unsigned a = conn[i], b = conn[i + 1], c = conn[i + 2];
+    if (a >= numPoints || b >= numPoints || c >= numPoints || a == b ||
+        b == c || c == a) {
+      malformed++;
+      continue;
+    }
+    sound.push_back(a);
+    sound.push_back(b);
+    sound.push_back(c);
+  }
+  return malformed;
+}
+
+void Validator::check(const std::vector<double> &x,
+                      const std::vector<double> &y,
+                      const std::vector<unsigned> &conn,
+                      const EdgeTable &table) {
+  numElements = conn.size() / 3;
+  numEdges = table.numEdges();
+  overfull = table.numOverfullEdges();
+  badAdjacency = 0;
+  // Only count nodes that are actually used by an element
+  std::vector<bool> used(x.size(), false);
+  for (unsigned i = 0; i < conn.size(); i++) {
+    used[conn[i]] = true;
+  }
+  numNodes = std::count(used.begin(), used.end(), true);
+  // Split the edges between threads, each keeps its own counters
+  unsigned threads = std::min(numThreads, std::max(numEdges / 16384, 1u));
+  std::vector<unsigned> deg(threads, 0), fold(threads, 0), nonDel(threads, 0);
+  unsigned chunk = (numEdges + threads - 1) / threads;
+  if (threads == 1) {
+    checkEdges(x, y, conn, table, 0, numEdges, deg[0], fold[0], nonDel[0]);
+  } else {
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; t++) {
+      unsigned begin = t * chunk;
+      unsigned end = std::min(numEdges, begin + chunk);
+      pool.push_back(std::thread(&Validator::checkEdges, this, std::cref(x),
+                                 std::cref(y), std::cref(conn),
+                                 std::cref(table), begin, end,
+                                 std::ref(deg[t]), std::ref(fold[t]),
+                                 std::ref(nonDel[t])));
+    }
+    for (unsigned t = 0; t < pool.size(); t++) {
+      pool[t].join();
+    }
+  }
+  degenerate = folded = nonDelaunay = 0;
+  for (unsigned t = 0; t < threads; t++) {
+    degenerate += deg[t];
+    folded += fold[t];
+    nonDelaunay += nonDel[t];
+  }
+}
+
+void Validator::checkEdges(const std::vector<double> &x,
+                           const std::vector<double> &y,
+                           const std::vector<unsigned> &conn,
+                           const EdgeTable &table, unsigned begin,
+                           unsigned end, unsigned &deg, unsigned &fold,
+                           unsigned &nonDel) const {
+  Trace::Span span("verify range", "worker");
+  for (unsigned e = begin; e < end; e++) {
+    unsigned p = table.edgeNode(e, 0);
+    unsigned q = table.edgeNode(e, 1);
+    int opposite[2] = {-1, -1};
+    double side[2] = {0, 0};
+    for (int s = 0; s < 2; s++) {
+      int elem = table.edgeElement(e, s);
+      if (elem == -1) {
+        continue;
+      }
+      for (int k = 0; k < 3; k++) {
+        unsigned c = conn[3 * elem + k];
+        if (c != p && c != q) {
+          opposite[s] = c;
+        }
+      }
+      side[s] = orient2d(x[p], y[p], x[q], y[q], x[opposite[s]],
+                         y[opposite[s]]);
+      // Count each element once, from the edge joining its first two nodes
+      if (side[s] == 0 && table.find(conn[3 * elem], conn[3 * elem + 1]) ==
+                              (int)e) {
+        deg++;
+      }
+    }
+    if (opposite[1] == -1 || side[0] == 0 || side[1] == 0) {
+      continue;
+    }
+    if ((side[0] > 0) == (side[1] > 0)) {
+      fold++;
+      continue;
+    }
+    // Orient the circle test so (p, q, opposite[0]) is counterclockwise
+    double inCircle =
+        side[0] > 0 ? incircle(x[p], y[p], x[q], y[q], x[opposite[0]],
+                               y[opposite[0]], x[opposite[1]], y[opposite[1]])
+                    : incircle(x[q], y[q], x[p], y[p], x[opposite[0]],
+                               y[opposite[0]], x[opposite[1]], y[opposite[1]]);
+    if (inCircle > 0) {
+      nonDel++;
+    }
+  }
+}
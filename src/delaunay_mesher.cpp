@@ -0,0 +1,83 @@
+#include "../include/delaunay_mesher.h"
+#include "../include/MeshLibrary.h"
+#include <exception>
+#include <string>
+#include <vector>
+
+// Exceptions must not cross the C boundary: every entry point catches them
+// and leaves the message for dm_last_error
+struct dm_mesh {
+  std::vector<double> x, y;
+  std::vector<uint32_t> conn;
+};
+
+static std::string lastError;
+
+static int fail(const std::exception &e) {
+  lastError = e.what();
+  return DM_ERROR;
+}
+
+static dm_mesh *wrap(std::vector<double> &x, std::vector<double> &y,
+                     const std::vector<unsigned> &conn) {
+  dm_mesh *mesh = new dm_mesh;
+  mesh->x.swap(x);
+  mesh->y.swap(y);
+  mesh->conn.assign(conn.begin(), conn.end());
+  return mesh;
+}
+
+int dm_mesh_rectangle(double x_min, double y_min, double x_max, double y_max,
+                      double x_size, double y_size, int delaunay,
+                      dm_mesh **out) {
+  try {
+    std::vector<double> x, y;
+    std::vector<unsigned> conn;
+    meshRectangle(x_min, y_min, x_max, y_max, x_size, y_size, x, y, conn,
+                  delaunay != 0);
+    *out = wrap(x, y, conn);
+    return DM_OK;
+  } catch (const std::exception &e) {
+    *out = nullptr;
+    return fail(e);
+  } catch (...) {
+    *out = nullptr;
+    lastError = "Unknown error\n";
+    return DM_ERROR;
+  }
+}
+
+int dm_mesh_points(const double *px, const double *py, size_t n, int delaunay,
+                   dm_mesh **out) {
+  try {
+    std::vector<double> x, y;
+    std::vector<unsigned> conn;
+    meshPoints(std::vector<double>(px, px + n), std::vector<double>(py, py + n),
+               x, y, conn, delaunay != 0);
+    *out = wrap(x, y, conn);
+    return DM_OK;
+  } catch (const std::exception &e) {
+    *out = nullptr;
+    return fail(e);
+  } catch (...) {
+    *out = nullptr;
+    lastError = "Unknown error\n";
+    return DM_ERROR;
+  }
+}
+
+size_t dm_num_nodes(const dm_mesh *mesh) { return mesh->x.size(); }
+
+size_t dm_num_elements(const dm_mesh *mesh) { return mesh->conn.size() / 3; }
+
+const double *dm_x(const dm_mesh *mesh) { return mesh->x.data(); }
+
+const double *dm_y(const dm_mesh *mesh) { return mesh->y.data(); }
+
+const uint32_t *dm_connectivity(const dm_mesh *mesh) {
+  return mesh->conn.data();
+}
+
+void dm_free(dm_mesh *mesh) { delete mesh; }
+
+const char *dm_last_error(void) { return lastError.c_str(); }
@@ -1,10 +1,20 @@
+#include "../include/Allocations.h"
 #include "../include/Body.h"
+#include "../include/Differential.h"
 #include "../include/Mesh.h"
+#include "../include/MeshLibrary.h"
+#include "../include/Ordering.h"
 //#include "../lib/matplotlib-cpp-master/matplotlibcpp.h"
+#include <algorithm>
 #include <cstdlib>
+#include <chrono>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <sstream>
+#include <string>
+#include <vector>
 
 /* TODO:
 1. Check all copy constructors and assignment constructors are done to std
@@ -25,28 +35,535 @@ void printErrorToFile(const char *fileName, const std::exception &e) {
   w.close();
 }
 
+struct Options {
+  bool qualityFlag = false;
+  bool verifyFlag = false;
+  bool verifyFailed = false;
+  bool loadFlag = false;
+  unsigned threads = 1;
+  std::string renumberMethod;
+  std::string reorderMethod;
+  unsigned numParts = 0;
+  bool inertialFlag = false;
+  std::string assembleProblem;
+  std::string colorMethod;
+  bool graphsFlag = false;
+  bool binaryFlag = false;
+  bool geometryFlag = false;
+  bool compactFlag = false;
+  unsigned tiles = 0;
+  std::string renderFormat;
+  std::string shadeMetric;
+  unsigned imageSize = 1024;
+  std::string regressFile;
+  std::string timesFile;
+  unsigned differentialSize = 0;
+  unsigned scalingSize = 0;
+  std::string traceFile;
+  bool allocationsFlag = false;
+  bool priorityFlag = false;
+  Triangulation::FlipBudget budget;
+};
+
+void printUsage() {
+  fprintf(stderr, "Usage: mesh-generator [options] <input file(s)>\n"
+                  "Options:\n"
+                  "  --differential <n>\n"
+                  "                 Compare meshing engines with the\n"
+                  "                 reference on generated grids of up to\n"
+                  "                 n x n cells (no input files)\n"
+                  "  --scaling <n>  Time mesh() per element on generated\n"
+                  "                 grids of 32 x 32 up to n x n cells (no\n"
+                  "                 input files)\n"
+                  "  --regress <baselines>\n"
+                  "                 Mesh each input without writing it and\n"
+                  "                 compare its hash with the baselines\n"
+                  "                 file; new inputs are added\n"
+                  "  --times <file> With --regress, also compare run times\n"
+                  "                 with this machine's timings file\n"
+                  "  --tiles <n>    Mesh each input as n x n tiles, one at a\n"
+                  "                 time, into <input>.tiled.msh\n"
+                  "  --load         Inputs are existing .msh files: read\n"
+                  "                 them back and Delaunay them again\n"
+                  "  --priority     Take the largest min-angle gains first,\n"
+                  "                 within the budgets below; a run they\n"
+                  "                 stop writes <input>.budget.msh\n"
+                  "  --target-angle <deg>\n"
+                  "                 Stop once no angle is smaller\n"
+                  "  --time-budget <s>\n"
+                  "                 Stop after this many seconds\n"
+                  "  --flip-budget <n>\n"
+                  "                 Stop after this many flips\n"
+                  "  --quality      Write <output>.qual quality report\n"
+                  "  --verify       Check the Delaunay mesh is valid and\n"
+                  "                 report the edge flip counts\n"
+                  "  --renumber <rcm|sloan>\n"
+                  "                 Reorder Delaunay mesh nodes for bandwidth\n"
+                  "                 (rcm) or profile (sloan)\n"
+                  "  --reorder <hilbert|morton>\n"
+                  "                 Sort Delaunay mesh elements and nodes\n"
+                  "                 along a space-filling curve\n"
+                  "  --partition <k>\n"
+                  "                 Write <output>.part<p>.msh for k parts,\n"
+                  "                 with one halo layer and global maps\n"
+                  "  --inertial     Partition by inertial bisection\n"
+                  "  --assemble <poisson|elasticity>\n"
+                  "                 Write P1 stiffness matrix to <output>.csr\n"
+                  "                 and report assembly speed\n"
+                  "  --color <greedy|jp>\n"
+                  "                 Report node-sharing element coloring\n"
+                  "                 (jp: parallel Jones-Plassmann)\n"
+                  "  --graphs       Write node and element dual graphs to\n"
+                  "                 <output>.nodes.graph and .dual.graph\n"
+                  "                 (METIS format)\n"
+                  "  --binary       Also write the Delaunay mesh to\n"
+                  "                 <output>.bin\n"
+                  "  --geometry     Include element areas, inverse\n"
+                  "                 Jacobians and P1 gradients in the .bin\n"
+                  "  --compact      Mesh each input straight into float\n"
+                  "                 coordinates and 32-bit indices, into\n"
+                  "                 <input>.compact.msh (and .bin with\n"
+                  "                 --binary), and report bytes/triangle\n"
+                  "  --render <ppm|png|svg>\n"
+                  "                 Draw the Delaunay mesh to\n"
+                  "                 <output>.<format>\n"
+                  "  --shade <angle|aspect|edge|area>\n"
+                  "                 Color rendered elements by quality\n"
+                  "  --image-size <n>\n"
+                  "                 Longest rendered side in pixels\n"
+                  "  --trace <file> Write a Chrome trace-event timeline of\n"
+                  "                 every input and phase, per thread\n"
+                  "  --allocations  Count heap allocations per phase and\n"
+                  "                 report them at the end\n"
+                  "  --threads <n>  Worker threads for analysis passes\n");
+}
+
+void finishMesh(Mesh &meshedBody, const char *fileName, Options &opt) {
+  // Everything that happens to a mesh once it has been Delaunay-ified
+  if (opt.priorityFlag) {
+    std::cout << meshedBody.DelaunayPriority(fileName, opt.budget)
+              << std::endl;
+  } else {
+    meshedBody.Delaunay();
+  }
+  if (!opt.renumberMethod.empty()) {
+    std::cout << meshedBody.renumber(fileName, opt.renumberMethod)
+              << std::endl;
+  }
+  if (!opt.reorderMethod.empty()) {
+    std::cout << meshedBody.reorder(fileName, opt.reorderMethod) << std::endl;
+  }
+  meshedBody.printMesh(fileName);
+  if (opt.binaryFlag) {
+    meshedBody.printBinary(fileName, opt.geometryFlag);
+  }
+  if (opt.graphsFlag) {
+    std::cout << meshedBody.printGraphs(fileName) << std::endl;
+  }
+  if (opt.numParts > 0) {
+    std::cout << meshedBody.partition(fileName, opt.numParts,
+                                      opt.inertialFlag)
+              << std::endl;
+  }
+  if (!opt.assembleProblem.empty()) {
+    std::cout << meshedBody.assemble(fileName, opt.assembleProblem,
+                                     opt.threads)
+              << std::endl;
+  }
+  if (!opt.colorMethod.empty()) {
+    std::cout << meshedBody.color(fileName, opt.colorMethod, opt.threads)
+              << std::endl;
+  }
+  if (!opt.renderFormat.empty()) {
+    std::cout << meshedBody.render(fileName, opt.renderFormat,
+                                   opt.shadeMetric, opt.imageSize,
+                                   opt.threads)
+              << std::endl;
+  }
+  if (opt.qualityFlag) {
+    std::cout << meshedBody.quality(fileName, opt.threads) << std::endl;
+  }
+  if (opt.verifyFlag) {
+    Validator V = meshedBody.verify(opt.threads);
+    const Triangulation *T = meshedBody.getTriangulation();
+    std::cout << T->fileRoot(fileName) << ": " << V.summary() << "\n"
+              << T->fileRoot(fileName) << ": " << T->flipSummary()
+              << std::endl;
+    // Flips stopped by a budget leave a valid mesh that is not Delaunay
+    if (!V.isValid() || (T->isDelaunay() && !V.isDelaunay())) {
+      opt.verifyFailed = true;
+    }
+  }
+}
+
+std::map<std::string, std::string> readBaselines(const std::string &file) {
+  // "<input> <value>" lines; a missing file is an empty set of baselines
+  std::map<std::string, std::string> base;
+  std::ifstream r(file.c_str());
+  std::string name, value;
+  while (r >> name >> value) {
+    base[name] = value;
+  }
+  r.close();
+  return base;
+}
+
+void writeBaselines(const std::string &file,
+                    const std::map<std::string, std::string> &base) {
+  std::ofstream w(file.c_str());
+  if (!(w.is_open())) {
+    fprintf(stderr, "Error opening %s", file.c_str());
+    exit(EXIT_FAILURE);
+  }
+  std::map<std::string, std::string>::const_iterator it;
+  for (it = base.begin(); it != base.end(); ++it) {
+    w << it->first << " " << it->second << "\n";
+  }
+  w.close();
+}
+
+int regress(const std::vector<char *> &files, const std::string &hashFile,
+            const std::string &timesFile) {
+  // A changed hash fails; inputs that throw hash the message, so a
+  // different error fails too. Hashes are the same on every machine and
+  // are versioned. Times are not, so they are only checked against a
+  // local times file, when one is given: the best of three runs, failing
+  // at 1.5 times the baseline from 100 ms up, and at twice the baseline
+  // plus 10 ms below that, where it is mostly noise.
+  std::map<std::string, std::string> hashes = readBaselines(hashFile);
+  std::map<std::string, std::string> times;
+  if (!timesFile.empty()) {
+    times = readBaselines(timesFile);
+  }
+  unsigned failed = 0, added = 0, timed = 0;
+  for (unsigned i = 0; i < files.size(); i++) {
+    std::string hash;
+    double best = 0;
+    for (int run = 0; run < (timesFile.empty() ? 1 : 3); run++) {
+      std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      try {
+        Body inputBody(files[i]);
+        Mesh meshedBody(inputBody);
+        meshedBody.mesh();
+        meshedBody.Delaunay();
+        std::ostringstream s;
+        s << std::hex << std::setw(16) << std::setfill('0')
+          << meshedBody.hash();
+        hash = s.str();
+      } catch (const std::exception &e) {
+        // FNV-1a of the message, like the mesh hash
+        uint64_t h = 14695981039346656037ull;
+        for (const char *c = e.what(); *c != '\0'; c++) {
+          h = (h ^ (unsigned char)*c) * 1099511628211ull;
+        }
+        std::ostringstream s;
+        s << "error-" << std::hex << std::setw(16) << std::setfill('0') << h;
+        hash = s.str();
+      }
+      std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - start;
+      best = run == 0 ? elapsed.count() : std::min(best, elapsed.count());
+    }
+    std::cout << files[i] << ": hash " << hash << ", " << best << " s";
+    if (hashes.count(files[i]) == 0) {
+      hashes[files[i]] = hash;
+      added++;
+      std::cout << " (new baseline)";
+    } else if (hash != hashes[files[i]]) {
+      std::cout << " MESH CHANGED, expected " << hashes[files[i]];
+      failed++;
+    }
+    if (!timesFile.empty()) {
+      if (times.count(files[i]) == 0) {
+        std::ostringstream s;
+        s << best;
+        times[files[i]] = s.str();
+        timed++;
+      } else {
+        double expected = atof(times[files[i]].c_str());
+        std::cout << " (baseline " << expected << " s)";
+        if (best > (expected >= 0.1 ? 1.5 * expected
+                                    : 2 * expected + 0.01)) {
+          std::cout << " SLOWER";
+          failed++;
+        }
+      }
+    }
+    std::cout << std::endl;
+  }
+  if (added > 0) {
+    writeBaselines(hashFile, hashes);
+  }
+  if (timed > 0) {
+    writeBaselines(timesFile, times);
+  }
+  std::cout << files.size() << " inputs, " << failed << " regressions, "
+            << added << " new baselines";
+  if (!timesFile.empty()) {
+    std::cout << ", " << timed << " new timings";
+  }
+  std::cout << std::endl;
+  return failed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int differential(const Options &opt) {
+  // The reference inserts the points in the order given and flips by the
+  // original min-angle rule; candidates are the alternatives the mesher
+  // has, add new engines here
+  Differential D(
+      [](const std::vector<double> &px, const std::vector<double> &py,
+         std::vector<double> &x, std::vector<double> &y,
+         std::vector<unsigned> &conn) {
+        Body inputBody(1, 1, *std::min_element(px.begin(), px.end()),
+                       *std::min_element(py.begin(), py.end()),
+                       *std::max_element(px.begin(), px.end()),
+                       *std::max_element(py.begin(), py.end()));
+        Mesh meshedBody(inputBody);
+        meshedBody.mesh(px, py);
+        meshedBody.DelaunayMinAngle();
+        meshedBody.getTriangulation()->getArrays(x, y, conn);
+      },
+      opt.threads);
+  D.addEngine("incircle", [](const std::vector<double> &px,
+                             const std::vector<double> &py,
+                             std::vector<double> &x, std::vector<double> &y,
+                             std::vector<unsigned> &conn) {
+    // The default flips: exact incircle test, perturbed ties
+    meshPoints(px, py, x, y, conn);
+  });
+  D.addEngine("hilbert", [](const std::vector<double> &px,
+                            const std::vector<double> &py,
+                            std::vector<double> &x, std::vector<double> &y,
+                            std::vector<unsigned> &conn) {
+    // Insert the points along a Hilbert curve
+    std::vector<unsigned> order = Ordering::curve(px, py);
+    std::vector<double> sx(px.size()), sy(py.size());
+    for (unsigned i = 0; i < order.size(); i++) {
+      sx[i] = px[order[i]];
+      sy[i] = py[order[i]];
+    }
+    meshPoints(sx, sy, x, y, conn);
+  });
+  D.addEngine("priority", [](const std::vector<double> &px,
+                             const std::vector<double> &py,
+                             std::vector<double> &x, std::vector<double> &y,
+                             std::vector<unsigned> &conn) {
+    // As meshPoints, but run to convergence with the largest gains first
+    Body inputBody(1, 1, *std::min_element(px.begin(), px.end()),
+                   *std::min_element(py.begin(), py.end()),
+                   *std::max_element(px.begin(), px.end()),
+                   *std::max_element(py.begin(), py.end()));
+    Mesh meshedBody(inputBody);
+    meshedBody.mesh(px, py);
+    meshedBody.DelaunayPriority("", Triangulation::FlipBudget());
+    meshedBody.getTriangulation()->getArrays(x, y, conn);
+  });
+  D.addEngine("compact", [](const std::vector<double> &px,
+                            const std::vector<double> &py,
+                            std::vector<double> &x, std::vector<double> &y,
+                            std::vector<unsigned> &conn) {
+    // Float coordinates and packed arrays; the corners are in the box
+    // already, so inserting them again skips them
+    CompactMesh compact(*std::min_element(px.begin(), px.end()),
+                        *std::min_element(py.begin(), py.end()),
+                        *std::max_element(px.begin(), px.end()),
+                        *std::max_element(py.begin(), py.end()), px.size());
+    for (unsigned i = 0; i < px.size(); i++) {
+      compact.insert(px[i], py[i]);
+    }
+    compact.getArrays(x, y, conn);
+  });
+  std::vector<unsigned> sizes;
+  for (unsigned n = 4; n <= opt.differentialSize; n *= 2) {
+    sizes.push_back(n);
+  }
+  try {
+    std::cout << D.run(sizes) << std::endl;
+  } catch (const std::exception &e) {
+    std::cout << "The reference engine failed: \n" << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return D.numFailures() > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int scaling(const Options &opt) {
+  // Time per element of mesh() on n x n cells of the unit square, beside
+  // the rebuild of the same mesh from its flat arrays. The rebuild does
+  // O(1) work per element, so where both grow together the growth is the
+  // memory hierarchy, not the algorithm. Best of 3 runs each.
+  std::cout << "   cells   elements   mesh() us/elem   rebuild us/elem"
+            << std::endl;
+  for (unsigned n = 32; n <= opt.scalingSize; n *= 2) {
+    double meshTime = INFINITY, rebuildTime = INFINITY;
+    unsigned elements = 0;
+    for (int run = 0; run < 3; run++) {
+      double h = 1.0 / n;
+      Body inputBody(h, h, 0, 0, 1, 1);
+      Mesh meshedBody(inputBody);
+      std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      meshedBody.mesh();
+      std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - start;
+      meshTime = std::min(meshTime, elapsed.count());
+      std::vector<double> x, y;
+      std::vector<unsigned> conn;
+      meshedBody.getTriangulation()->getArrays(x, y, conn);
+      elements = conn.size() / 3;
+      std::vector<Node *> nodes;
+      for (unsigned i = 0; i < x.size(); i++) {
+        nodes.push_back(new Node(x[i], y[i]));
+      }
+      start = std::chrono::steady_clock::now();
+      {
+        Triangulation rebuilt(nodes, conn);
+        elapsed = std::chrono::steady_clock::now() - start;
+      }
+      rebuildTime = std::min(rebuildTime, elapsed.count());
+      for (unsigned i = 0; i < nodes.size(); i++) {
+        delete nodes[i];
+      }
+    }
+    std::cout << std::setw(8) << (std::to_string(n) + "^2") << std::setw(11)
+              << elements << std::fixed << std::setprecision(2)
+              << std::setw(17) << meshTime / elements * 1e6 << std::setw(18)
+              << rebuildTime / elements * 1e6 << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
+
 int main(int argc, char **argv) {
-  if (argc < 2) {
-    fprintf(stderr, "Usage: mesh-generator <input file>\n");
+  Options opt;
+  std::vector<char *> files;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--quality") {
+      opt.qualityFlag = true;
+    } else if (arg == "--verify") {
+      opt.verifyFlag = true;
+    } else if (arg == "--tiles" && i + 1 < argc) {
+      opt.tiles = std::max(atoi(argv[++i]), 0);
+    } else if (arg == "--differential" && i + 1 < argc) {
+      opt.differentialSize = std::max(atoi(argv[++i]), 0);
+    } else if (arg == "--scaling" && i + 1 < argc) {
+      opt.scalingSize = std::max(atoi(argv[++i]), 0);
+    } else if (arg == "--regress" && i + 1 < argc) {
+      opt.regressFile = argv[++i];
+    } else if (arg == "--times" && i + 1 < argc) {
+      opt.timesFile = argv[++i];
+    } else if (arg == "--priority") {
+      opt.priorityFlag = true;
+    } else if (arg == "--target-angle" && i + 1 < argc) {
+      opt.budget.minAngle = atof(argv[++i]);
+    } else if (arg == "--time-budget" && i + 1 < argc) {
+      opt.budget.seconds = atof(argv[++i]);
+    } else if (arg == "--flip-budget" && i + 1 < argc) {
+      opt.budget.flips = std::max(atoi(argv[++i]), 0);
+    } else if (arg == "--load") {
+      opt.loadFlag = true;
+    } else if (arg == "--renumber" && i + 1 < argc) {
+      opt.renumberMethod = argv[++i];
+    } else if (arg == "--reorder" && i + 1 < argc) {
+      opt.reorderMethod = argv[++i];
+    } else if (arg == "--partition" && i + 1 < argc) {
+      opt.numParts = std::max(atoi(argv[++i]), 0);
+    } else if (arg == "--inertial") {
+      opt.inertialFlag = true;
+    } else if (arg == "--assemble" && i + 1 < argc) {
+      opt.assembleProblem = argv[++i];
+    } else if (arg == "--color" && i + 1 < argc) {
+      opt.colorMethod = argv[++i];
+    } else if (arg == "--graphs") {
+      opt.graphsFlag = true;
+    } else if (arg == "--binary") {
+      opt.binaryFlag = true;
+    } else if (arg == "--geometry") {
+      opt.binaryFlag = true;
+      opt.geometryFlag = true;
+    } else if (arg == "--compact") {
+      opt.compactFlag = true;
+    } else if (arg == "--render" && i + 1 < argc) {
+      opt.renderFormat = argv[++i];
+    } else if (arg == "--shade" && i + 1 < argc) {
+      opt.shadeMetric = argv[++i];
+    } else if (arg == "--image-size" && i + 1 < argc) {
+      opt.imageSize = std::max(atoi(argv[++i]), 0);
+    } else if (arg == "--trace" && i + 1 < argc) {
+      opt.traceFile = argv[++i];
+    } else if (arg == "--allocations") {
+      opt.allocationsFlag = true;
+    } else if (arg == "--threads" && i + 1 < argc) {
+      opt.threads = std::max(atoi(argv[++i]), 1);
+    } else if (arg.compare(0, 2, "--") == 0) {
+      printUsage();
+      return EXIT_FAILURE;
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+  if (opt.differentialSize > 0) {
+    return differential(opt);
+  }
+  if (opt.scalingSize > 0) {
+    return scaling(opt);
+  }
+  if (files.size() == 0 ||
+      (opt.compactFlag &&
+       (opt.geometryFlag || opt.loadFlag || opt.tiles > 0))) {
+    printUsage();
     return EXIT_FAILURE;
   }
-  for (int j = 0; j < 2; j++) { // run it twice, randomize second time
-    for (int i = 1; i < argc; i++) {
+  if (!opt.regressFile.empty()) {
+    return regress(files, opt.regressFile, opt.timesFile);
+  }
+  if (!opt.traceFile.empty()) {
+    Trace::enable();
+  }
+  if (opt.allocationsFlag) {
+    Allocations::enable();
+  }
+  // Loaded, tiled and compact meshes are built once, generated ones twice
+  int runs = (opt.loadFlag || opt.tiles > 0 || opt.compactFlag) ? 1 : 2;
+  for (int j = 0; j < runs; j++) { // run it twice, randomize second time
+    for (unsigned i = 0; i < files.size(); i++) {
+      Trace::Span span(j == 0 ? "input" : "randomized input", "input",
+                       files[i]);
       try {
-        Body inputBody(argv[i]);
+        if (opt.tiles > 0) {
+          // Tiles are freed as they are written, nothing is left to analyze
+          Body inputBody(files[i]);
+          Mesh meshedBody(inputBody);
+          std::cout << meshedBody.meshTiled(files[i], opt.tiles) << std::endl;
+          continue;
+        }
+        if (opt.compactFlag) {
+          // Only the compact arrays are built, so no other output applies
+          Body inputBody(files[i]);
+          Mesh meshedBody(inputBody);
+          std::cout << meshedBody.compact(files[i], opt.binaryFlag)
+                    << std::endl;
+          continue;
+        }
+        if (opt.loadFlag) {
+          Mesh meshedBody;
+          meshedBody.load(files[i]);
+          finishMesh(meshedBody, files[i], opt);
+          continue;
+        }
+        Body inputBody(files[i]);
         Mesh meshedBody(inputBody);
         if (j == 0) {
           meshedBody.mesh();
-          meshedBody.printMesh(argv[i]); // Print the mesh
+          meshedBody.printMesh(files[i]); // Print the mesh
         } else {
           meshedBody.randomize();
-          meshedBody.printMesh(argv[i]);
+          meshedBody.printMesh(files[i]);
         }
-        meshedBody.Delaunay();
-        meshedBody.printMesh(argv[i]);
+        finishMesh(meshedBody, files[i], opt);
       } catch (const std::exception &e) {
-        printErrorToFile(argv[i], e);
-        std::cout << "There was an error with file `" << argv[i]
+        printErrorToFile(files[i], e);
+        std::cout << "There was an error with file `" << files[i]
                   << "`. The following exception was thrown: \n"
                   << e.what() << "No mesh was created.\n"
                   << std::endl;
@@ -54,5 +571,11 @@ int main(int argc, char **argv) {
       }
     }
   }
-  return EXIT_SUCCESS;
+  if (opt.allocationsFlag) {
+    std::cout << Allocations::report() << std::endl;
+  }
+  if (!opt.traceFile.empty()) {
+    Trace::write(opt.traceFile.c_str());
+  }
+  return opt.verifyFailed ? EXIT_FAILURE : EXIT_SUCCESS;
 }